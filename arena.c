@@ -0,0 +1,516 @@
+#include "arena.h"
+#include "trace.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BOARD_CELLS (BOARD_ROWS * BOARD_COLS)
+
+static const char DIRS[4]   = { 'N', 'S', 'W', 'E' };
+static const int  DIR_DX[4] = {  0,   0,  -1,   1  };
+static const int  DIR_DY[4] = { -1,   1,   0,   0  };
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int cell_of(Position p) {
+    return p.y * BOARD_COLS + p.x;
+}
+
+static bool in_board(int x, int y) {
+    return x >= 0 && x < BOARD_COLS && y >= 0 && y < BOARD_ROWS;
+}
+
+/* 头能不能走进这一格：没墙没雷没障碍，也没有任何机器人 */
+static bool cell_free(const Arena *arena, int x, int y) {
+    if (!in_board(x, y)) return false;
+    int c = y * BOARD_COLS + x;
+    return !arena->blocked[c] && arena->occupancy[c] == 0;
+}
+
+/* ================== 创建 / 销毁 ================== */
+
+Arena *arena_create(int robots, int people, int mines, int threads) {
+    if (robots < 1) robots = 1;
+    if (robots > ARENA_MAX_ROBOTS) robots = ARENA_MAX_ROBOTS;
+    if (people < 1) people = 1;
+    if (mines < 0) mines = 0;
+
+    Arena *arena = calloc(1, sizeof(Arena));
+    if (!arena) return NULL;
+
+    arena->robot_count  = robots;
+    arena->people_count = people;
+    arena->mine_count   = mines;
+    arena->bots      = calloc((size_t)robots, sizeof(ArenaBot));
+    arena->people    = calloc((size_t)people, sizeof(Position));
+    arena->mines     = calloc((size_t)(mines > 0 ? mines : 1), sizeof(Position));
+    arena->blocked   = calloc(BOARD_CELLS, 1);
+    arena->occupancy = calloc(BOARD_CELLS, sizeof(unsigned short));
+    arena->graph     = graph_create(BOARD_COLS, BOARD_ROWS);
+    arena->pool      = pool_create(threads);
+    if (!arena->bots || !arena->people || !arena->mines ||
+        !arena->blocked || !arena->occupancy || !arena->graph || !arena->pool) {
+        arena_destroy(arena);
+        return NULL;
+    }
+
+    /* 机器人复用单机版的 Robot（环形身体 + move_robot），身体固定几节 */
+    for (int i = 0; i < robots; i++) {
+        Robot *robot = &arena->bots[i].robot;
+        robot->body_cap   = ARENA_BODY_SEGMENTS;
+        robot->body       = calloc(ARENA_BODY_SEGMENTS, sizeof(Position));
+        robot->body_cells = calloc(BOARD_CELLS, sizeof(unsigned short));
+        if (!robot->body || !robot->body_cells) {
+            arena_destroy(arena);
+            return NULL;
+        }
+    }
+    return arena;
+}
+
+void arena_destroy(Arena *arena) {
+    if (!arena) return;
+    if (arena->bots) {
+        for (int i = 0; i < arena->robot_count; i++) {
+            free(arena->bots[i].robot.body);
+            free(arena->bots[i].robot.body_cells);
+        }
+    }
+    if (arena->pool) pool_destroy(arena->pool);
+    graph_destroy(arena->graph);
+    arena_set_horizon(arena, 0);
+    free(arena->bots);
+    free(arena->people);
+    free(arena->mines);
+    free(arena->blocked);
+    free(arena->occupancy);
+    free(arena);
+}
+
+bool arena_set_horizon(Arena *arena, int horizon) {
+    if (horizon < 0) horizon = 0;
+    if (horizon > ARENA_MAX_HORIZON) horizon = ARENA_MAX_HORIZON;
+
+    free(arena->reserved);
+    free(arena->seen);
+    free(arena->parent);
+    free(arena->queue);
+    arena->reserved = NULL;
+    arena->seen     = NULL;
+    arena->parent   = NULL;
+    arena->queue    = NULL;
+    arena->horizon  = 0;
+    arena->stamp    = 0;
+    if (horizon == 0) return true;
+
+    size_t states = (size_t)(horizon + 1) * BOARD_CELLS;
+    arena->reserved = calloc(states, sizeof(unsigned short));
+    arena->seen     = calloc(states, sizeof(unsigned int));
+    arena->parent   = malloc(states * sizeof(int));
+    arena->queue    = malloc(states * sizeof(int));
+    if (!arena->reserved || !arena->seen || !arena->parent || !arena->queue) {
+        arena_set_horizon(arena, 0);
+        return false;
+    }
+    arena->horizon = horizon;
+    return true;
+}
+
+/* ================== 开局 / 刷新 ================== */
+
+static bool person_at(const Arena *arena, int x, int y) {
+    for (int i = 0; i < arena->people_count; i++) {
+        if (arena->people[i].x == x && arena->people[i].y == y) return true;
+    }
+    return false;
+}
+
+/* 随机找一格空地（没墙、没机器人、没人）；实在找不到返回 false */
+static bool random_free_cell(Arena *arena, Position *out) {
+    for (int tries = 0; tries < 4 * BOARD_CELLS; tries++) {
+        int x = 1 + rand_r(&arena->rng) % (BOARD_COLS - 2);
+        int y = 1 + rand_r(&arena->rng) % (BOARD_ROWS - 2);
+        if (!cell_free(arena, x, y) || person_at(arena, x, y)) continue;
+        out->x = x;
+        out->y = y;
+        return true;
+    }
+    return false;
+}
+
+static void occupy(Arena *arena, Position p, int delta) {
+    if (in_board(p.x, p.y)) arena->occupancy[cell_of(p)] += delta;
+}
+
+/* 放到随机空地，身体先叠在头上，走几步就展开。
+ * 找不到空地返回 false，这时先叠在顶上一格，下一步撞了会再找一次 */
+static bool spawn_bot(Arena *arena, ArenaBot *bot) {
+    Robot *robot = &bot->robot;
+
+    Position p = { BOARD_COLS / 2, 1 };
+    bool found = random_free_cell(arena, &p);
+
+    robot->pos         = p;
+    robot->direction   = DIRS[rand_r(&arena->rng) % 4];
+    robot->ai_mode     = true;
+    robot->body_head   = 0;
+    robot->body_length = ARENA_BODY_SEGMENTS;
+    for (int i = 0; i < ARENA_BODY_SEGMENTS; i++) robot->body[i] = p;
+    memset(robot->body_cells, 0, sizeof(unsigned short) * BOARD_CELLS);
+    robot->body_cells[cell_of(p)] = ARENA_BODY_SEGMENTS;
+
+    occupy(arena, p, 1 + ARENA_BODY_SEGMENTS);
+    return found;
+}
+
+/* 刷新一个人；没空地就先空着（-1, -1），之后每步再试 */
+static void respawn_person(Arena *arena, Position *p) {
+    p->x = -1;
+    p->y = -1;
+    Position q;
+    if (random_free_cell(arena, &q)) *p = q;
+}
+
+bool arena_reset(Arena *arena, unsigned int seed) {
+    arena->rng  = seed;
+    arena->tick = 0;
+    init_obstacle(&arena->obstacle);
+
+    memset(arena->occupancy, 0, sizeof(unsigned short) * BOARD_CELLS);
+    for (int i = 0; i < arena->people_count; i++) {
+        arena->people[i].x = -1;
+        arena->people[i].y = -1;
+    }
+
+    /* 墙和障碍 */
+    for (int y = 0; y < BOARD_ROWS; y++) {
+        for (int x = 0; x < BOARD_COLS; x++) {
+            bool wall = x == 0 || x == BOARD_COLS - 1 || y == 0 || y == BOARD_ROWS - 1;
+            arena->blocked[y * BOARD_COLS + x] =
+                wall || is_obstacle_position(&arena->obstacle, x, y);
+        }
+    }
+
+    /* 雷；没空地的那几颗不放，留在 (-1, -1) */
+    for (int i = 0; i < arena->mine_count; i++) {
+        Position p = { -1, -1 };
+        if (random_free_cell(arena, &p)) arena->blocked[cell_of(p)] = 1;
+        arena->mines[i] = p;
+    }
+
+    graph_reset(arena->graph);
+    for (int c = 0; c < BOARD_CELLS; c++) {
+        if (arena->blocked[c]) graph_block(arena->graph, c % BOARD_COLS, c / BOARD_COLS);
+    }
+    graph_rebuild(arena->graph);
+
+    bool ok = true;
+    for (int i = 0; i < arena->robot_count; i++) {
+        ArenaBot *bot = &arena->bots[i];
+        bot->score      = 0;
+        bot->deaths     = 0;
+        bot->plan_nodes = 0;
+        bot->rng        = seed * 2654435761u + (unsigned int)i;
+        if (!spawn_bot(arena, bot)) ok = false;
+    }
+
+    for (int i = 0; i < arena->people_count; i++) {
+        respawn_person(arena, &arena->people[i]);
+    }
+    return ok;
+}
+
+/* ================== 规划：每个机器人一次 BFS（并行） ================== */
+
+/* 没路：随便找一个能走的方向，都不能走就认命 */
+static void plan_fallback(const Arena *arena, ArenaBot *bot) {
+    Robot *robot = &bot->robot;
+    int first = rand_r(&bot->rng) % 4;
+    for (int k = 0; k < 4; k++) {
+        int d = (first + k) % 4;
+        if (cell_free(arena, robot->pos.x + DIR_DX[d], robot->pos.y + DIR_DY[d])) {
+            set_direction(robot, DIRS[d]);
+            return;
+        }
+    }
+}
+
+/* 朝相邻格 c 走 */
+static void head_towards(Robot *robot, int c) {
+    for (int d = 0; d < 4; d++) {
+        if (robot->pos.x + DIR_DX[d] == c % BOARD_COLS &&
+            robot->pos.y + DIR_DY[d] == c / BOARD_COLS) {
+            set_direction(robot, DIRS[d]);
+            return;
+        }
+    }
+}
+
+/*
+ * 在能走格子图上 BFS，只剩"有没有机器人"要逐格判。
+ * 图的邻接表是 东、西、南、北，倒着读正好是这里的 北、南、西、东
+ */
+static void plan_one(void *ctx, int index) {
+    const Arena *arena = ctx;
+    const CellGraph *graph = arena->graph;
+    ArenaBot *bot   = &arena->bots[index];
+    Robot    *robot = &bot->robot;
+
+    int start = graph_id(graph, robot->pos.x, robot->pos.y);
+    if (start < 0) {
+        bot->plan_nodes = 0;
+        plan_fallback(arena, bot);
+        return;
+    }
+
+    /* prev[i]：从哪个编号走到 i 的，-1 = 还没到过；栈上的，每个线程各一份 */
+    int prev[BOARD_CELLS];
+    int queue[BOARD_CELLS];
+    memset(prev, -1, sizeof(int) * (size_t)graph->n);
+
+    int front = 0, back = 0;
+    int found = -1;
+    queue[back++] = start;
+    prev[start] = start;
+
+    while (front < back) {
+        int u = queue[front++];
+        int c = graph->cell[u];
+        if (u != start && person_at(arena, c % BOARD_COLS, c / BOARD_COLS)) {
+            found = u;
+            break;
+        }
+        for (int e = graph->offset[u + 1] - 1; e >= graph->offset[u]; e--) {
+            int v = graph->edge[e];
+            if (prev[v] != -1 || arena->occupancy[graph->cell[v]]) continue;
+            prev[v] = u;
+            queue[back++] = v;
+        }
+    }
+    bot->plan_nodes = (unsigned long)front;
+
+    if (found >= 0) {
+        /* 倒着找回起点的下一格 */
+        int u = found;
+        while (prev[u] != start) u = prev[u];
+        head_towards(robot, graph->cell[u]);
+        return;
+    }
+
+    plan_fallback(arena, bot);
+}
+
+/* ================== 协作规划：时空预约表（串行） ================== */
+
+/*
+ * 时空状态 s = t * 格子数 + c：第 t 步头在格子 c。
+ * reserved[s] 非 0 表示那一步那一格已经有机器人（头或身体）压着。
+ */
+
+/* 当前局面已经决定的未来占用：第 t 步时，头和身体里最后 t 节已经走掉，
+ * 剩下的前 L+1-t 格一定还被这个机器人压着（不管它往哪走） */
+static void reserve_current(Arena *arena, int index) {
+    const Robot *robot = &arena->bots[index].robot;
+    unsigned short me = (unsigned short)(index + 1);
+    int L = robot->body_length;
+
+    for (int t = 1; t <= L && t <= arena->horizon; t++) {
+        for (int j = 0; j <= L - t; j++) {
+            Position p = j == 0 ? robot->pos : robot_segment(robot, j - 1);
+            if (in_board(p.x, p.y)) arena->reserved[t * BOARD_CELLS + cell_of(p)] = me;
+        }
+    }
+}
+
+/* 从状态 s 走进格子 n 会不会撞上自己这条路上刚走过的格子（下一步的身体） */
+static bool hits_own_trail(const Arena *arena, int s, int n) {
+    for (int k = 1; k < ARENA_BODY_SEGMENTS; k++) {
+        s = arena->parent[s];
+        /* t = 0 那一段是当前身体，已经在 reserve_current 里登记过 */
+        if (s < BOARD_CELLS) return false;
+        if (s % BOARD_CELLS == n) return true;
+    }
+    return false;
+}
+
+/* 到最近一个人的曼哈顿距离；看不到人时用来挑一个"往人那边靠"的终点 */
+static int person_distance(const Arena *arena, int c) {
+    int x = c % BOARD_COLS, y = c / BOARD_COLS;
+    int best = INT_MAX;
+    for (int i = 0; i < arena->people_count; i++) {
+        const Position *p = &arena->people[i];
+        if (p->x < 0) continue;
+        int d = abs(p->x - x) + abs(p->y - y);
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+static void plan_cooperative(Arena *arena, int index) {
+    const CellGraph *graph = arena->graph;
+    ArenaBot *bot   = &arena->bots[index];
+    Robot    *robot = &bot->robot;
+    int H = arena->horizon;
+
+    if (++arena->stamp == 0) {
+        memset(arena->seen, 0, sizeof(unsigned int) * (size_t)(H + 1) * BOARD_CELLS);
+        arena->stamp = 1;
+    }
+    unsigned int stamp = arena->stamp;
+    unsigned int *seen = arena->seen;
+    int *parent = arena->parent;
+    int *queue  = arena->queue;
+
+    int start = cell_of(robot->pos);
+    int front = 0, back = 0;
+    queue[back++] = start;
+    seen[start]   = stamp;
+    parent[start] = -1;
+
+    /* 先碰到人就停；horizon 内碰不到人，就取走得最远的状态：
+     * 能走满 horizon 步的在第 H 步里挑离人最近的，走不满（被堵住了）
+     * 就取最深那一层先出队的那个，不比远近 */
+    int goal = -1;
+    int best = start, best_dist = INT_MAX;
+
+    while (front < back) {
+        int s = queue[front++];
+        int t = s / BOARD_CELLS, c = s % BOARD_CELLS;
+        int x = c % BOARD_COLS, y = c / BOARD_COLS;
+
+        if (t > 0 && person_at(arena, x, y)) {
+            goal = s;
+            break;
+        }
+        if (t > best / BOARD_CELLS) {     // 更深一层：先记下第一个
+            best = s;
+            best_dist = INT_MAX;
+        }
+        if (t == H) {
+            int dist = person_distance(arena, c);
+            if (dist < best_dist) {
+                best = s;
+                best_dist = dist;
+            }
+            continue;
+        }
+
+        /* 邻接表倒着读：北、南、西、东 */
+        int u = graph->id[c];
+        if (u < 0) continue;
+        for (int e = graph->offset[u + 1] - 1; e >= graph->offset[u]; e--) {
+            int n  = graph->cell[graph->edge[e]];
+            int ns = (t + 1) * BOARD_CELLS + n;
+            if (arena->reserved[ns] || seen[ns] == stamp) continue;
+            if (hits_own_trail(arena, s, n)) continue;
+            seen[ns]   = stamp;
+            parent[ns] = s;
+            queue[back++] = ns;
+        }
+    }
+    bot->plan_nodes = (unsigned long)front;
+
+    int end = goal >= 0 ? goal : best;
+    int t_end = end / BOARD_CELLS;
+    if (t_end == 0) {
+        /* 第一步就无路可走（被围死了）：照旧随便挑个方向 */
+        plan_fallback(arena, bot);
+        return;
+    }
+
+    int path[ARENA_MAX_HORIZON + 1];
+    for (int s = end; s >= 0; s = parent[s]) path[s / BOARD_CELLS] = s % BOARD_CELLS;
+
+    /* 登记自己这条路：第 t 步压着 path[t-L .. t]，路走完之后身体还要再拖几步 */
+    unsigned short me = (unsigned short)(index + 1);
+    for (int t = 1; t <= H; t++) {
+        for (int k = 0; k <= ARENA_BODY_SEGMENTS; k++) {
+            int i = t - k;
+            if (i < 1 || i > t_end) continue;
+            arena->reserved[t * BOARD_CELLS + path[i]] = me;
+        }
+    }
+    head_towards(robot, path[1]);
+}
+
+static void plan_all_cooperative(Arena *arena) {
+    int n = arena->robot_count;
+    memset(arena->reserved, 0,
+           sizeof(unsigned short) * (size_t)(arena->horizon + 1) * BOARD_CELLS);
+    for (int i = 0; i < n; i++) reserve_current(arena, i);
+
+    /* 优先级和移动顺序一样每个 tick 轮换 */
+    for (int k = 0; k < n; k++) {
+        plan_cooperative(arena, (int)((arena->tick + k) % n));
+    }
+}
+
+void arena_plan(Arena *arena) {
+    TRACE_BEGIN("arena_plan");
+    uint64_t t0 = now_ns();
+    if (arena->horizon > 0)
+        plan_all_cooperative(arena);
+    else
+        pool_run(arena->pool, plan_one, arena, arena->robot_count);
+    arena->plan_ns = now_ns() - t0;
+    TRACE_END("arena_plan");
+}
+
+/* ================== 移动：串行，更新占用表 ================== */
+
+void arena_step(Arena *arena) {
+    TRACE_BEGIN("arena_step");
+    uint64_t t0 = now_ns();
+    int n = arena->robot_count;
+
+    /* 所有尾巴先一起让出来，跟着谁的尾巴走都安全，和移动顺序无关 */
+    for (int i = 0; i < n; i++) {
+        occupy(arena, robot_tail(&arena->bots[i].robot), -1);
+    }
+
+    for (int k = 0; k < n; k++) {
+        ArenaBot *bot   = &arena->bots[(arena->tick + k) % n];
+        Robot    *robot = &bot->robot;
+
+        move_robot(robot);
+
+        if (!cell_free(arena, robot->pos.x, robot->pos.y)) {
+            /* 头还没登记；身体里已经含旧头了 */
+            for (int i = 0; i < robot->body_length; i++) {
+                occupy(arena, robot_segment(robot, i), -1);
+            }
+            bot->deaths++;
+            spawn_bot(arena, bot);  // 没空地也没关系：叠着的那格下一步撞了会再找
+            continue;
+        }
+        occupy(arena, robot->pos, 1);
+
+        for (int i = 0; i < arena->people_count; i++) {
+            Position *p = &arena->people[i];
+            if (p->x != robot->pos.x || p->y != robot->pos.y) continue;
+            bot->score += 10;
+            respawn_person(arena, p);
+            break;
+        }
+    }
+
+    /* 之前没空地刷不出来的人 */
+    for (int i = 0; i < arena->people_count; i++) {
+        if (arena->people[i].x < 0) respawn_person(arena, &arena->people[i]);
+    }
+
+    arena->tick++;
+    arena->step_ns = now_ns() - t0;
+    TRACE_END("arena_step");
+}
+
+void arena_tick(Arena *arena) {
+    arena_plan(arena);
+    arena_step(arena);
+}
@@ -0,0 +1,94 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdint.h>
+
+#include "engine.h"
+#include "threadpool.h"
+
+/* ================== 多机器人竞技场 ================== */
+
+/*
+ * 一张棋盘上很多 AI 机器人抢着救人：
+ *   - 棋盘、十字障碍和单机版一样，雷开局撒好后不再变；
+ *   - 同时有 people_count 个人，谁的头先到谁得 10 分，人马上在别处刷新
+ *     （没空地就先空着，之后每步再试）；
+ *   - 头撞到墙、雷、障碍或任何机器人（包括自己）的头和身体就死，
+ *     当场在随机空地复活，分数保留，deaths 加一。
+ *
+ * 每个 tick 分两步：
+ *   1. 规划（arena_plan）：每个机器人各自 BFS 到最近的人。只读共享状态，
+ *      只写自己的方向和计数，所以整批丢给线程池并行；
+ *   2. 移动（arena_step）：串行地一个个走一步、更新共享占用表、判碰撞和救人。
+ *      起始编号每个 tick 轮换一位，谁也不会总是先走。结果和线程数无关。
+ *
+ * occupancy 是每格压着几个机器人格子（头 + 身体），随移动增量维护；
+ * blocked 是墙、障碍和雷，开局算一次。
+ *
+ * 协作规划（arena_set_horizon，horizon > 0）：
+ *   各自 BFS 的路径会迎头撞上。换成按优先级串行规划：每个机器人在
+ *   (格子, 第几步) 的时空图里 BFS，避开预约表里别人已经占下的 (格子, 步)，
+ *   规划完把自己头和身体未来 horizon 步要压的格子也登记进预约表。
+ *   每个 tick 重新规划一次（窗口式），优先级和移动顺序一起轮换。
+ *   这一步天生是串行的，不走线程池。
+ */
+
+#define ARENA_MAX_ROBOTS     1024
+#define ARENA_BODY_SEGMENTS  2
+#define ARENA_MAX_HORIZON    64
+
+typedef struct {
+    Robot         robot;
+    int           score;
+    int           deaths;
+    unsigned int  rng;          // 每个机器人自己的随机数，规划时并行用
+    unsigned long plan_nodes;   // 上一次规划 BFS 展开的节点数
+} ArenaBot;
+
+typedef struct {
+    int             robot_count;
+    ArenaBot       *bots;
+
+    int             people_count;
+    Position       *people;
+
+    int             mine_count;
+    Position       *mines;
+    CrossObstacle   obstacle;
+
+    unsigned char  *blocked;    // BOARD_ROWS*BOARD_COLS
+    CellGraph      *graph;      // blocked 以外的格子编成的图，开局编一次，规划都顺着它走
+    unsigned short *occupancy;  // BOARD_ROWS*BOARD_COLS
+
+    unsigned int    rng;        // 刷新人、复活位置用（只在串行的移动步里用）
+    long            tick;
+
+    /* 协作规划；horizon = 0 时不分配，用各自独立的 BFS */
+    int             horizon;
+    unsigned short *reserved;   // [(horizon+1) * 格子数]，0 = 空，否则机器人编号 + 1
+    unsigned int   *seen;       // 时空 BFS 的访问标记（按 stamp 比较，不用每次清零）
+    unsigned int    stamp;
+    int            *parent;     // 时空状态 t*格子数 + c 的前一个状态
+    int            *queue;
+
+    ThreadPool     *pool;
+    uint64_t        plan_ns;    // 上一个 tick 的规划 / 移动耗时（墙钟）
+    uint64_t        step_ns;
+} Arena;
+
+/* 失败返回 NULL；robots 超过 ARENA_MAX_ROBOTS 会被截断 */
+Arena *arena_create(int robots, int people, int mines, int threads);
+void   arena_destroy(Arena *arena);
+
+/* 棋盘上找不到空地放下每个机器人返回 false（机器人太多） */
+bool arena_reset(Arena *arena, unsigned int seed);
+
+/* 0 = 独立 BFS（并行）；> 0 = 协作规划，往前看 horizon 步（最多 ARENA_MAX_HORIZON）。
+ * 内存不够返回 false，退回独立 BFS */
+bool arena_set_horizon(Arena *arena, int horizon);
+
+void arena_plan(Arena *arena);
+void arena_step(Arena *arena);
+void arena_tick(Arena *arena);      // plan + step
+
+#endif
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "engine.h"
+
+/*
+ * AI 策略对比：每个版本的规则在同一批种子上无界面自动玩
+ *
+ * 编译方式：
+ *      make bench_ai
+ *
+ * 运行方式（默认 20 局/版本，每局最多 5000 步）：
+ *      ./bench_ai [games] [max_ticks]
+ *
+ * 输出 CSV，每个版本一行：
+ *   决策延迟（每次 move_robot_ai 的 ns，p50/p90/p99/max），
+ *   以及平均分数、平均到达等级、平均存活步数、跑满 max_ticks 的局数、
+ *   最长的蛇身（经典模式才会一直长）。
+ *
+ * 大棋盘：make bench_ai CFLAGS="-O2 -DBOARD_ROWS=200 -DBOARD_COLS=200"
+ * 掉命后相当于玩家直接按 y 继续；model1 开局是手动模式，这里强制打开 AI。
+ * 计时本身约几十 ns，贪心 AI 的延迟里这部分占比不小。
+ * 贪心 AI 常常在障碍物附近来回绕圈、既不死也不得分，所以 games_capped 要一起看。
+ */
+
+#define DEFAULT_GAMES      20
+#define DEFAULT_MAX_TICKS  5000
+
+static const RuleSet *const VARIANTS[] = {
+    &RULES_MODEL1, &RULES_MODEL2, &RULES_MODEL3,
+    &RULES_MODEL4, &RULES_MODEL5, &RULES_MODEL6,
+    &RULES_CLASSIC,
+};
+#define N_VARIANTS ((int)(sizeof(VARIANTS) / sizeof(VARIANTS[0])))
+
+static long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/* ================== 延迟样本 ================== */
+
+typedef struct {
+    unsigned int *ns;
+    long count;
+    long cap;
+} Samples;
+
+static void samples_push(Samples *s, long ns) {
+    if (s->count == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 65536;
+        unsigned int *tmp = realloc(s->ns, sizeof(unsigned int) * s->cap);
+        if (!tmp) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        s->ns = tmp;
+    }
+    s->ns[s->count++] = (unsigned int)(ns > 0xffffffffL ? 0xffffffffL : ns);
+}
+
+static int compare_uint(const void *a, const void *b) {
+    unsigned int x = *(const unsigned int *)a;
+    unsigned int y = *(const unsigned int *)b;
+    return (x > y) - (x < y);
+}
+
+/* 已排序样本的百分位（最近秩） */
+static unsigned int percentile(const Samples *s, double p) {
+    if (s->count == 0) return 0;
+    long k = (long)(p / 100.0 * s->count + 0.5);
+    if (k < 1) k = 1;
+    if (k > s->count) k = s->count;
+    return s->ns[k - 1];
+}
+
+/* ================== 无界面跑一局 ================== */
+
+typedef struct {
+    int  score;
+    int  level;
+    long ticks;
+    bool capped;    // 跑满 max_ticks 还没死
+    int  body_max;  // 这一局蛇身最长到多少节
+} GameResult;
+
+static GameResult play_one(GameWorld *world, unsigned int seed,
+                           long max_ticks, Samples *lat) {
+    world_reset(world, seed);
+    world->robot.ai_mode = true;
+
+    GameResult res = {0};
+    bool running = true;
+
+    while (running && res.ticks < max_ticks) {
+        long t0 = now_ns();
+        move_robot_ai(world);
+        samples_push(lat, now_ns() - t0);
+
+        move_robot(&world->robot);
+        res.ticks++;
+
+        bool life_lost = false;
+        check_collision(world, &running, &life_lost);
+        if (!running || world->player.lives <= 0) break;
+        if (life_lost) continue;
+
+        handle_rescue(world);
+        if (world->robot.body_length > res.body_max) res.body_max = world->robot.body_length;
+    }
+
+    res.score  = world->player.score;
+    res.level  = world->player.level;
+    res.capped = running && world->player.lives > 0;
+    return res;
+}
+
+int main(int argc, char **argv) {
+    int  games     = (argc > 1) ? atoi(argv[1]) : DEFAULT_GAMES;
+    long max_ticks = (argc > 2) ? atol(argv[2]) : DEFAULT_MAX_TICKS;
+    if (games < 1) games = 1;
+    if (max_ticks < 1) max_ticks = 1;
+
+    printf("variant,ai,games,decisions,lat_p50_ns,lat_p90_ns,lat_p99_ns,lat_max_ns,"
+           "score_mean,level_mean,ticks_mean,games_capped,body_max\n");
+
+    for (int v = 0; v < N_VARIANTS; v++) {
+        const RuleSet *rules = VARIANTS[v];
+        GameWorld *world = world_create(rules);
+        if (!world) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+
+        Samples lat = {0};
+        double score_sum = 0, level_sum = 0, ticks_sum = 0;
+        int capped = 0, body_max = 0;
+
+        /* 种子 1..games：每个版本用同一批 */
+        for (int g = 0; g < games; g++) {
+            GameResult r = play_one(world, (unsigned int)(g + 1), max_ticks, &lat);
+            score_sum += r.score;
+            level_sum += r.level;
+            ticks_sum += r.ticks;
+            if (r.capped) capped++;
+            if (r.body_max > body_max) body_max = r.body_max;
+        }
+
+        qsort(lat.ns, lat.count, sizeof(unsigned int), compare_uint);
+
+        printf("%s,%s,%d,%ld,%u,%u,%u,%u,%.1f,%.2f,%.1f,%d,%d\n",
+               rules->name, rules->ai == AI_BFS ? "bfs" : "greedy",
+               games, lat.count,
+               percentile(&lat, 50), percentile(&lat, 90),
+               percentile(&lat, 99), lat.count ? lat.ns[lat.count - 1] : 0,
+               score_sum / games, level_sum / games, ticks_sum / games,
+               capped, body_max);
+
+        free(lat.ns);
+        world_destroy(world);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "arena.h"
+
+/*
+ * 竞技场扩展性：机器人数 × 线程数，无界面跑固定 tick 数
+ *
+ * 编译方式：
+ *      make bench_arena
+ *
+ * 运行方式（默认每组 2000 tick）：
+ *      ./bench_arena [ticks]
+ *
+ * 输出 CSV，每组一行：每 tick 的规划 / 移动耗时（us），每个机器人每 tick
+ * 的规划耗时和展开的节点数，总 tick 速率，以及全场的救人数和死亡数。
+ *
+ * planner = bfs：各自独立 BFS，并行规划、串行移动，所以机器人少的时候
+ *   线程多反而慢（唤醒 worker 的开销比 BFS 还贵）。同一个种子下结果和
+ *   线程数无关，rescues / deaths 每行应该对得上。
+ * planner = coop：时空预约表协作规划（horizon = COOP_HORIZON），串行，只跑 1 线程。
+ */
+
+#define DEFAULT_TICKS 2000
+#define PEOPLE        8
+#define MINES         10
+#define SEED          1u
+#define COOP_HORIZON  16
+
+static const int ROBOTS[] = { 8, 32, 128 };
+#define N_ROBOTS ((int)(sizeof(ROBOTS) / sizeof(ROBOTS[0])))
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+typedef struct {
+    double plan_us, step_us, ticks_per_sec;
+    double nodes_per_robot;
+    long   rescues, deaths;
+} ArenaRun;
+
+static ArenaRun run_arena(Arena *arena, long ticks) {
+    ArenaRun run = {0};
+    if (!arena_reset(arena, SEED)) {
+        fprintf(stderr, "the board has no room for %d robots\n", arena->robot_count);
+        exit(1);
+    }
+
+    uint64_t plan_ns = 0, step_ns = 0;
+    double nodes = 0;
+    uint64_t t0 = now_ns();
+    for (long i = 0; i < ticks; i++) {
+        arena_plan(arena);
+        plan_ns += arena->plan_ns;
+        for (int b = 0; b < arena->robot_count; b++) nodes += arena->bots[b].plan_nodes;
+        arena_step(arena);
+        step_ns += arena->step_ns;
+    }
+    double sec = (double)(now_ns() - t0) / 1e9;
+
+    for (int i = 0; i < arena->robot_count; i++) {
+        run.rescues += arena->bots[i].score / 10;
+        run.deaths  += arena->bots[i].deaths;
+    }
+    run.plan_us         = plan_ns / 1000.0 / ticks;
+    run.step_us         = step_ns / 1000.0 / ticks;
+    run.ticks_per_sec   = ticks / sec;
+    run.nodes_per_robot = nodes / ticks / arena->robot_count;
+    return run;
+}
+
+static void print_row(const char *planner, const Arena *arena, long ticks, const ArenaRun *r) {
+    printf("%s,%d,%d,%ld,%.2f,%.3f,%.1f,%.2f,%.0f,%ld,%ld\n",
+           planner, arena->robot_count, pool_threads(arena->pool), ticks,
+           r->plan_us, r->plan_us / arena->robot_count, r->nodes_per_robot,
+           r->step_us, r->ticks_per_sec, r->rescues, r->deaths);
+}
+
+int main(int argc, char **argv) {
+    long ticks = (argc > 1) ? atol(argv[1]) : DEFAULT_TICKS;
+    if (ticks < 1) ticks = 1;
+
+    int nproc = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int threads[] = { 1, 2, 4, nproc };
+    int n_threads = nproc > 4 ? 4 : 3;
+
+    printf("planner,robots,threads,ticks,plan_us_per_tick,plan_us_per_robot,"
+           "nodes_per_robot,step_us_per_tick,ticks_per_sec,rescues,deaths\n");
+
+    for (int r = 0; r < N_ROBOTS; r++) {
+        for (int t = 0; t < n_threads; t++) {
+            Arena *arena = arena_create(ROBOTS[r], PEOPLE, MINES, threads[t]);
+            if (!arena) {
+                fprintf(stderr, "out of memory\n");
+                return 1;
+            }
+            ArenaRun run = run_arena(arena, ticks);
+            print_row("bfs", arena, ticks, &run);
+            arena_destroy(arena);
+        }
+
+        Arena *arena = arena_create(ROBOTS[r], PEOPLE, MINES, 1);
+        if (!arena || !arena_set_horizon(arena, COOP_HORIZON)) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        ArenaRun run = run_arena(arena, ticks);
+        print_row("coop", arena, ticks, &run);
+        arena_destroy(arena);
+    }
+    return 0;
+}
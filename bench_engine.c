@@ -0,0 +1,437 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "engine.h"
+
+/*
+ * 引擎热点函数的微基准
+ *
+ * 编译方式：
+ *      make bench_engine
+ *
+ * 运行方式（默认种子 1 2 3，地雷数 5 / 25 / 50）：
+ *      ./bench_engine [seed ...]
+ *
+ * 正确性检查（make check）：随机挡住 / 放开 / 加人 / 去人 ops 次，
+ * 每次都拿增量修出来的距离场和整张 BFS 比，对不上就报错退出：
+ *      ./bench_engine --check [ops]
+ *
+ * 输出 CSV：每个 (函数, 种子, 地雷数) 跑 BENCH_RUNS 轮，
+ * 每轮 iters 次调用，给出 ns/op 的平均值、标准差和最小值。
+ * iters 先自动标定到一轮大约 BENCH_RUN_NS。
+ */
+
+#define BENCH_RUNS    10
+#define BENCH_RUN_NS  5e6     // 每轮目标 5ms
+#define BENCH_MAX_ITERS (1L << 24)
+
+static const int MINE_COUNTS[] = {BASE_MINES, 25, MAX_MINES};
+#define N_MINE_COUNTS ((int)(sizeof(MINE_COUNTS) / sizeof(MINE_COUNTS[0])))
+
+/* 防止编译器把被测调用优化掉 */
+static volatile long Sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* ================== 被测函数 ================== */
+
+/* 每个函数跑 iters 次，返回总耗时（ns） */
+typedef double (*BenchFn)(GameWorld *world, int mines, long iters);
+
+static double bench_bfs(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    long acc = 0;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        char dir = 0;
+        acc += bfs_next_direction(&world->robot, &world->people[0],
+                                  world->graph, &dir);
+        acc += dir;
+    }
+    double t = now_ns() - t0;
+    Sink += acc;
+    return t;
+}
+
+/* 场上同时有 k 个人时一次 AI 决策的耗时：查距离场，应该和 k 无关 */
+static double bench_ai_people(GameWorld *world, int k, long iters) {
+    world_set_people(world, k);
+
+    long acc = 0;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        move_robot_ai(world);
+        acc += world->robot.direction;
+    }
+    double t = now_ns() - t0;
+    Sink += acc;
+    world_set_people(world, 1);
+    return t;
+}
+
+static double bench_ai_people1(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    return bench_ai_people(world, 1, iters);
+}
+
+static double bench_ai_people4(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    return bench_ai_people(world, 4, iters);
+}
+
+static double bench_ai_people16(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    return bench_ai_people(world, MAX_PEOPLE, iters);
+}
+
+/* 整张重算距离场（开局时才做），给下面的增量修补当参照 */
+static double bench_field_rebuild(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        Sink += (long)distfield_rebuild(world->field);
+    }
+    return now_ns() - t0;
+}
+
+/* 挡一格再放开，各重编一次图：相当于 spawn_mines、炸弹之后各一次 */
+static double bench_graph_rebuild(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    CellGraph *graph = world->graph;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        graph_block(graph, 1, 1);
+        graph_rebuild(graph);
+        graph_unblock(graph, 1, 1);
+        graph_rebuild(graph);
+    }
+    double t = now_ns() - t0;
+    Sink += graph->n;
+    return t;
+}
+
+/* 每次先挡一格让图重编、表过期，再整张重算（model6 有安全出生点，建了距离表） */
+static double bench_oracle_rebuild(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    CellGraph  *graph  = world->graph;
+    DistOracle *oracle = world->oracle;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        graph_block(graph, 1, 1);
+        graph_rebuild(graph);
+        oracle_rebuild(oracle);
+        graph_unblock(graph, 1, 1);
+        graph_rebuild(graph);
+    }
+    double t = now_ns() - t0;
+    Sink += oracle_dist(oracle, 2, 2, 3, 3);
+    return t;
+}
+
+/* 在一个空格上放一颗雷再炸掉：两次增量修补，相当于 spawn_mines + 炸弹各一颗 */
+static double bench_field_mine_toggle(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    long acc = 0;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        int x = 1 + (int)((i * 7) % (BOARD_COLS - 2));
+        int y = 1 + (int)((i * 3) % (BOARD_ROWS - 2));
+        if (is_blocked_cell(x, y, world->mines, world->mine_count, &world->obstacle) ||
+            find_person_at(world, x, y) >= 0)
+            continue;
+        acc += (long)distfield_block(world->field, x, y);
+        acc += (long)distfield_unblock(world->field, x, y);
+    }
+    double t = now_ns() - t0;
+    Sink += acc;
+    return t;
+}
+
+static double bench_is_mine_at(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    long acc = 0;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        int x = (int)(i % BOARD_COLS);
+        int y = (int)((i / BOARD_COLS) % BOARD_ROWS);
+        acc += is_mine_at(world->mines, world->mine_count, x, y);
+    }
+    double t = now_ns() - t0;
+    Sink += acc;
+    return t;
+}
+
+static double bench_is_obstacle(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    long acc = 0;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        int x = (int)(i % BOARD_COLS);
+        int y = (int)((i / BOARD_COLS) % BOARD_ROWS);
+        acc += is_obstacle_position(&world->obstacle, x, y);
+    }
+    double t = now_ns() - t0;
+    Sink += acc;
+    return t;
+}
+
+/* 每次从 0 个雷补到 mines 个。旧雷先炸掉（不计时），
+ * 挡住的格子都放开，不然距离场 / 图 / HPA* 的挡住计数会越叠越多 */
+static double bench_spawn_mines(GameWorld *world, int mines, long iters) {
+    bool marks[MAX_MINES];
+    for (int i = 0; i < MAX_MINES; i++) marks[i] = true;
+
+    double t = 0.0;
+    for (long i = 0; i < iters; i++) {
+        remove_marked_mines(world, marks);
+        double t0 = now_ns();
+        spawn_mines(world, mines);
+        t += now_ns() - t0;
+    }
+    Sink += world->mine_count;
+    return t;
+}
+
+static double bench_spawn_person(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        spawn_person(world, 0);
+    }
+    double t = now_ns() - t0;
+    Sink += world->people[0].x;
+    return t;
+}
+
+static double bench_safe_spawn(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    long acc = 0;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        Position p = find_safe_spawn_position(world->mines, world->mine_count,
+                                              &world->obstacle);
+        acc += p.x + p.y;
+    }
+    double t = now_ns() - t0;
+    Sink += acc;
+    return t;
+}
+
+/* 机器人停在安全格上：测的是不掉命时每一步的检测开销 */
+static double bench_check_collision(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    bool running = true, life_lost = false;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        check_collision(world, &running, &life_lost);
+    }
+    double t = now_ns() - t0;
+    Sink += running + life_lost;
+    return t;
+}
+
+/* 左右来回走，位置不会跑出棋盘 */
+static double bench_move_robot(GameWorld *world, int mines, long iters) {
+    (void)mines;
+    Robot *robot = &world->robot;
+    double t0 = now_ns();
+    for (long i = 0; i < iters; i++) {
+        set_direction(robot, (i & 1) ? 'W' : 'E');
+        move_robot(robot);
+    }
+    double t = now_ns() - t0;
+    Sink += robot->pos.x;
+    return t;
+}
+
+typedef struct {
+    const char *name;
+    BenchFn     fn;
+} Bench;
+
+static const Bench BENCHES[] = {
+    {"bfs_next_direction",       bench_bfs},
+    {"move_robot_ai_people1",    bench_ai_people1},
+    {"move_robot_ai_people4",    bench_ai_people4},
+    {"move_robot_ai_people16",   bench_ai_people16},
+    {"distfield_rebuild",        bench_field_rebuild},
+    {"distfield_mine_toggle",    bench_field_mine_toggle},
+    {"graph_rebuild",            bench_graph_rebuild},
+    {"oracle_rebuild",           bench_oracle_rebuild},
+    {"is_mine_at",               bench_is_mine_at},
+    {"is_obstacle_position",     bench_is_obstacle},
+    {"spawn_mines",              bench_spawn_mines},
+    {"spawn_person",             bench_spawn_person},
+    {"find_safe_spawn_position", bench_safe_spawn},
+    {"check_collision",          bench_check_collision},
+    {"move_robot",               bench_move_robot},
+};
+#define N_BENCHES ((int)(sizeof(BENCHES) / sizeof(BENCHES[0])))
+
+/* ================== 距离场的增量修补 vs 整张 BFS ================== */
+
+/* 独立写的多源 BFS，不走 distfield.c 的代码 */
+static void reference_field(const DistField *df, unsigned short *dist, int *queue) {
+    int front = 0, back = 0;
+    for (int c = 0; c < df->cells; c++) {
+        dist[c] = DF_INF;
+        if (df->source[c] && !df->blocked[c]) {
+            dist[c] = 0;
+            queue[back++] = c;
+        }
+    }
+    static const int DX[4] = { 1, -1, 0, 0 }, DY[4] = { 0, 0, 1, -1 };
+    while (front < back) {
+        int c = queue[front++];
+        int x = c % df->w, y = c / df->w;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + DX[k], ny = y + DY[k];
+            if (nx < 0 || nx >= df->w || ny < 0 || ny >= df->h) continue;
+            int n = ny * df->w + nx;
+            if (df->blocked[n] || dist[n] != DF_INF) continue;
+            dist[n] = dist[c] + 1;
+            queue[back++] = n;
+        }
+    }
+}
+
+static int check_field(long ops) {
+    DistField *df = distfield_create(BOARD_COLS, BOARD_ROWS);
+    unsigned short *dist = malloc(sizeof(unsigned short) * BOARD_ROWS * BOARD_COLS);
+    int *queue = malloc(sizeof(int) * BOARD_ROWS * BOARD_COLS);
+    if (!df || !dist || !queue) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    /* 围墙 + 几个人，然后随机改 */
+    distfield_reset(df);
+    for (int y = 0; y < BOARD_ROWS; y++) {
+        for (int x = 0; x < BOARD_COLS; x++) {
+            if (x == 0 || x == BOARD_COLS - 1 || y == 0 || y == BOARD_ROWS - 1)
+                distfield_block(df, x, y);
+        }
+    }
+    distfield_add_source(df, BOARD_COLS / 2, BOARD_ROWS / 2);
+    distfield_rebuild(df);
+
+    unsigned int rng = 1;
+    for (long i = 0; i < ops; i++) {
+        int x = 1 + rand_r(&rng) % (BOARD_COLS - 2);
+        int y = 1 + rand_r(&rng) % (BOARD_ROWS - 2);
+        int c = y * BOARD_COLS + x;
+        const char *op;
+        /* 挡住的格子大约占一成，计数不超过 2，不会溢出 */
+        switch (rand_r(&rng) % 4) {
+            case 0:
+                op = "block";
+                if (df->blocked[c] < 2 && rand_r(&rng) % 10 == 0) distfield_block(df, x, y);
+                break;
+            case 1:
+                op = "unblock";
+                distfield_unblock(df, x, y);
+                break;
+            case 2:
+                op = "add_source";
+                if (df->source[c] < 2 && df->sources < 16) distfield_add_source(df, x, y);
+                break;
+            default:
+                op = "remove_source";
+                if (df->source[c] && df->sources > 1) distfield_remove_source(df, x, y);
+                break;
+        }
+
+        reference_field(df, dist, queue);
+        for (int k = 0; k < df->cells; k++) {
+            if (df->blocked[k] || df->dist[k] == dist[k]) continue;
+            fprintf(stderr, "distfield mismatch after op %ld (%s at %d,%d): "
+                    "cell %d,%d has %u, BFS says %u\n", i, op, x, y,
+                    k % BOARD_COLS, k / BOARD_COLS, df->dist[k], dist[k]);
+            return 1;
+        }
+    }
+
+    printf("distfield: %ld random changes, incremental field matches full BFS\n", ops);
+    free(queue);
+    free(dist);
+    distfield_destroy(df);
+    return 0;
+}
+
+/* ================== 固定场景 ================== */
+
+/* 用 seed 摆一个有 mines 个雷的棋盘，机器人在安全出生点、不处于无敌 */
+static void setup_world(GameWorld *world, unsigned int seed, int mines) {
+    world_reset(world, seed);
+    spawn_mines(world, mines);
+    place_robot(world);
+    reset_robot_body_from_lives(world);
+    world->robot.invincible = false;
+    world->robot.invincible_ticks = 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--check") == 0)
+        return check_field(argc > 2 ? atol(argv[2]) : 200000);
+
+    unsigned int default_seeds[] = {1, 2, 3};
+    int nseeds = (argc > 1) ? argc - 1 : 3;
+
+    GameWorld *world = world_create(&RULES_MODEL6);
+    if (!world) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    printf("function,seed,mines,iters,runs,ns_per_op_mean,ns_per_op_stddev,ns_per_op_min\n");
+    for (int s = 0; s < nseeds; s++) {
+        unsigned int seed = (argc > 1) ? (unsigned int)strtoul(argv[s + 1], NULL, 10)
+                                       : default_seeds[s];
+        for (int m = 0; m < N_MINE_COUNTS; m++) {
+            for (int b = 0; b < N_BENCHES; b++) {
+                double samples[BENCH_RUNS];
+
+                /* 标定 iters（顺便热身），不计入结果 */
+                long iters = 16;
+                for (;;) {
+                    setup_world(world, seed, MINE_COUNTS[m]);
+                    double t = BENCHES[b].fn(world, MINE_COUNTS[m], iters);
+                    if (t >= BENCH_RUN_NS || iters >= BENCH_MAX_ITERS) break;
+                    iters *= 2;
+                }
+
+                for (int r = 0; r < BENCH_RUNS; r++) {
+                    setup_world(world, seed, MINE_COUNTS[m]);
+                    samples[r] = BENCHES[b].fn(world, MINE_COUNTS[m], iters)
+                                 / iters;
+                }
+
+                double sum = 0.0, min = samples[0];
+                for (int r = 0; r < BENCH_RUNS; r++) {
+                    sum += samples[r];
+                    if (samples[r] < min) min = samples[r];
+                }
+                double mean = sum / BENCH_RUNS;
+                double var = 0.0;
+                for (int r = 0; r < BENCH_RUNS; r++) {
+                    var += (samples[r] - mean) * (samples[r] - mean);
+                }
+                double stddev = sqrt(var / (BENCH_RUNS - 1));
+
+                printf("%s,%u,%d,%ld,%d,%.2f,%.2f,%.2f\n",
+                       BENCHES[b].name, seed, MINE_COUNTS[m],
+                       iters, BENCH_RUNS, mean, stddev, min);
+            }
+        }
+    }
+
+    world_destroy(world);
+    return 0;
+}
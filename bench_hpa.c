@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hpa.h"
+
+/*
+ * 分层寻路（HPA*）对拍整张 BFS：路径长度和每次查询的耗时
+ *
+ * 编译方式：
+ *      make bench_hpa
+ *
+ * 运行方式（默认 256×256，每种墙密度 300 对起终点）：
+ *      ./bench_hpa [size] [trials]
+ *
+ * 每种墙密度（10% / 20% / 30%）一行 CSV。每对起终点之前随机翻几个格子
+ * （放墙或拆墙），然后从起点一步步照 hpa_next_direction 走到终点：
+ *   path_ratio        HPA* 走的总步数 / 整张 BFS 的最短步数
+ *   failures          走得到却没走到（返回 false、撞墙或绕太久），
+ *                     以及走不到却给了方向
+ *   first_mean_ns     翻完格子后的第一次查询，包括重算脏块
+ *   flush_mean_ns     其中重算脏块（flush_dirty / build_border / build_cluster）
+ *                     占多少：同一格马上再查一次，两次相减
+ *   query_p50/p99_ns  之后每一步的查询（块都是干净的）
+ *   bfs_mean_ns       同一块棋盘上一次整张 BFS，作对照
+ * 种子固定，同一台机器上前后两次的结果可以直接比较。
+ */
+
+#define DEFAULT_SIZE    256
+#define DEFAULT_TRIALS  300
+#define TOGGLES         5       // 每对起终点之前翻几个格子
+
+static const int WALL_PCT[] = { 10, 20, 30 };
+#define N_WALL_PCT ((int)(sizeof(WALL_PCT) / sizeof(WALL_PCT[0])))
+
+static long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/* ================== 延迟样本 ================== */
+
+typedef struct {
+    unsigned int *ns;
+    long count;
+    long cap;
+} Samples;
+
+static void samples_push(Samples *s, long ns) {
+    if (s->count == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 65536;
+        unsigned int *tmp = realloc(s->ns, sizeof(unsigned int) * s->cap);
+        if (!tmp) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        s->ns = tmp;
+    }
+    s->ns[s->count++] = (unsigned int)(ns > 0xffffffffL ? 0xffffffffL : ns);
+}
+
+static int compare_uint(const void *a, const void *b) {
+    unsigned int x = *(const unsigned int *)a;
+    unsigned int y = *(const unsigned int *)b;
+    return (x > y) - (x < y);
+}
+
+/* 已排序样本的百分位（最近秩） */
+static unsigned int percentile(const Samples *s, double p) {
+    if (s->count == 0) return 0;
+    long k = (long)(p / 100.0 * s->count + 0.5);
+    if (k < 1) k = 1;
+    if (k > s->count) k = s->count;
+    return s->ns[k - 1];
+}
+
+/* ================== 对照：整张 BFS ================== */
+
+typedef struct {
+    int w, h;
+    unsigned char *wall;    // [w*h]
+    int *dist;              // [w*h]，-1 走不到
+    int *queue;             // [w*h]
+} Board;
+
+/* 从 target 出发的整张 BFS，dist 是每格走到 target 的最短步数 */
+static void board_bfs(Board *b, int target) {
+    int w = b->w, cells = b->w * b->h;
+    for (int i = 0; i < cells; i++) b->dist[i] = -1;
+
+    int front = 0, back = 0;
+    b->dist[target] = 0;
+    b->queue[back++] = target;
+    while (front < back) {
+        int c = b->queue[front++];
+        int x = c % w, y = c / w;
+        int next[4] = {
+            x + 1 < w    ? c + 1 : -1,
+            x > 0        ? c - 1 : -1,
+            y + 1 < b->h ? c + w : -1,
+            y > 0        ? c - w : -1,
+        };
+        for (int k = 0; k < 4; k++) {
+            int n = next[k];
+            if (n < 0 || b->wall[n] || b->dist[n] >= 0) continue;
+            b->dist[n] = b->dist[c] + 1;
+            b->queue[back++] = n;
+        }
+    }
+}
+
+static void toggle_wall(Board *b, Hpa *hpa, int c) {
+    b->wall[c] = !b->wall[c];
+    if (b->wall[c]) hpa_block(hpa, c % b->w, c / b->w);
+    else            hpa_unblock(hpa, c % b->w, c / b->w);
+}
+
+static int random_free_cell(const Board *b, unsigned int *seed) {
+    int cells = b->w * b->h, c;
+    do c = rand_r(seed) % cells; while (b->wall[c]);
+    return c;
+}
+
+/* ================== 一种墙密度跑一行 ================== */
+
+static void run_density(int size, int wall_pct, int trials) {
+    Board b = { size, size, NULL, NULL, NULL };
+    int cells = size * size;
+    b.wall  = calloc(cells, 1);
+    b.dist  = malloc(sizeof(int) * cells);
+    b.queue = malloc(sizeof(int) * cells);
+    Hpa *hpa = hpa_create(size, size);
+    if (!b.wall || !b.dist || !b.queue || !hpa) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    unsigned int seed = 1234u + (unsigned int)wall_pct;
+    for (int i = 0; i < cells * wall_pct / 100; i++) {
+        int c = rand_r(&seed) % cells;
+        if (!b.wall[c]) toggle_wall(&b, hpa, c);
+    }
+    /* 先查一次把所有块建好，不算进 first_mean_ns */
+    {
+        int s = random_free_cell(&b, &seed);
+        int px = s % size, py = s / size;
+        char dir;
+        hpa_next_direction(hpa, px, py, &px, &py, 1, NULL, &dir);
+    }
+
+    Samples lat = {0};
+    long first_ns = 0, flush_ns = 0, first_count = 0, bfs_ns = 0;
+    long opt_steps = 0, hpa_steps = 0, failures = 0, unreachable = 0;
+
+    for (int t = 0; t < trials; t++) {
+        int start  = random_free_cell(&b, &seed);
+        int target;
+        do target = random_free_cell(&b, &seed); while (target == start);
+
+        for (int k = 0; k < TOGGLES; k++) {
+            int c = rand_r(&seed) % cells;
+            if (c != start && c != target) toggle_wall(&b, hpa, c);
+        }
+
+        long t0 = now_ns();
+        board_bfs(&b, target);
+        bfs_ns += now_ns() - t0;
+
+        int tx = target % size, ty = target / size;
+        int cur = start, steps = 0;
+        long limit = 4L * cells;
+        bool reachable = b.dist[start] >= 0;
+        if (!reachable) unreachable++;
+
+        while (cur != target && steps < limit) {
+            char dir;
+            t0 = now_ns();
+            bool ok = hpa_next_direction(hpa, cur % size, cur / size,
+                                         &tx, &ty, 1, NULL, &dir);
+            long ns = now_ns() - t0;
+            if (steps == 0) {
+                /* 块都干净了，同一格再查一次，差值就是重算脏块的开销 */
+                t0 = now_ns();
+                hpa_next_direction(hpa, cur % size, cur / size, &tx, &ty, 1, NULL, &dir);
+                flush_ns += ns - (now_ns() - t0);
+                first_ns += ns;
+                first_count++;
+            } else {
+                samples_push(&lat, ns);
+            }
+            if (!reachable) {
+                if (ok) failures++;
+                break;
+            }
+            if (!ok) break;
+
+            int next = dir == 'E' ? cur + 1 : dir == 'W' ? cur - 1 :
+                       dir == 'S' ? cur + size : cur - size;
+            if (b.wall[next]) break;
+            cur = next;
+            steps++;
+        }
+
+        if (!reachable) continue;
+        if (cur != target) {
+            failures++;
+            continue;
+        }
+        opt_steps += b.dist[start];
+        hpa_steps += steps;
+    }
+
+    qsort(lat.ns, lat.count, sizeof(unsigned int), compare_uint);
+
+    printf("%d,%d,%d,%ld,%ld,%.4f,%ld,%.0f,%.0f,%u,%u,%.0f\n",
+           size, wall_pct, trials, unreachable, lat.count + first_count,
+           opt_steps ? (double)hpa_steps / opt_steps : 0.0, failures,
+           first_count ? (double)first_ns / first_count : 0.0,
+           first_count ? (double)flush_ns / first_count : 0.0,
+           percentile(&lat, 50), percentile(&lat, 99),
+           (double)bfs_ns / trials);
+
+    free(lat.ns);
+    hpa_destroy(hpa);
+    free(b.wall);
+    free(b.dist);
+    free(b.queue);
+}
+
+int main(int argc, char **argv) {
+    int size   = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    int trials = (argc > 2) ? atoi(argv[2]) : DEFAULT_TRIALS;
+    if (size < 2 * HPA_CLUSTER) size = 2 * HPA_CLUSTER;
+    if (size > 4096) size = 4096;
+    if (trials < 1) trials = 1;
+
+    printf("size,walls_pct,trials,unreachable,queries,path_ratio,failures,"
+           "first_mean_ns,flush_mean_ns,query_p50_ns,query_p99_ns,bfs_mean_ns\n");
+    for (int i = 0; i < N_WALL_PCT; i++)
+        run_density(size, WALL_PCT[i], trials);
+    return 0;
+}
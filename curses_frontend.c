@@ -0,0 +1,932 @@
+#include <ncurses.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "curses_frontend.h"
+#include "leaderboard.h"
+#include "profiler.h"
+#include "trace.h"
+
+/* ================== 显示字符 ================== */
+
+#define ROBOT_BODY 'O'
+#define ROBOT_HEAD '^'
+#define PERSON     'P'
+#define MINE       'X'
+#define OBSTACLE   '#'
+
+/* 本帧往棋盘窗口写了多少格（profiler 的计数器） */
+static unsigned long cells_drawn;
+
+/* ================== 快进（看 AI 玩） ================== */
+
+/* 模拟速度倍数，+/- 切换；0 = 不限速（不睡眠） */
+static const int TURBO_STEPS[] = { 1, 2, 4, 8, 16, 0 };
+#define TURBO_STEP_COUNT ((int)(sizeof(TURBO_STEPS) / sizeof(TURBO_STEPS[0])))
+
+/* 快进时最多每 33ms 画一次（约 30Hz，终端再快也看不出来） */
+#define RENDER_INTERVAL_NS 33000000ull
+
+/* ================== 颜色 ================== */
+
+#define CP_ROBOT     1
+#define CP_PERSON    2
+#define CP_MINE      3
+#define CP_OBSTACLE  4
+#define CP_STATUS    5
+#define CP_BOARD_BG  6
+
+static void init_colors(void) {
+    if (!has_colors()) return;
+    start_color();
+    use_default_colors();
+
+    init_pair(CP_ROBOT,    COLOR_WHITE,  COLOR_BLACK);
+    init_pair(CP_PERSON,   COLOR_GREEN,  COLOR_BLACK);
+    init_pair(CP_MINE,     COLOR_RED,    COLOR_BLACK);
+    init_pair(CP_OBSTACLE, COLOR_YELLOW, COLOR_BLACK);
+    init_pair(CP_STATUS,   COLOR_CYAN,   -1);
+    init_pair(CP_BOARD_BG, COLOR_WHITE,  COLOR_BLACK);
+}
+
+/* ================== 标题界面 ================== */
+
+/* 静态部分；名字输入框由 draw_name_field 单独刷新 */
+static void draw_title_screen(const RuleSet *rules) {
+    clear();
+
+    int ymax, xmax;
+    getmaxyx(stdscr, ymax, xmax);
+    (void)ymax;
+
+    const char *title = "Rescue Bot: Snake on a Minefield";
+    mvprintw(2, (xmax - (int)strlen(title)) / 2, "%s", title);
+
+    mvprintw(4, 4, "Description:");
+    mvprintw(5, 6, "Guide a snake-like robot to rescue people on a minefield.");
+    mvprintw(6, 6, "Avoid walls, mines and the central cross obstacle (#).");
+    if (rules->growth) {
+        mvprintw(7, 6, "Classic snake: every rescue grows the robot by one segment.");
+        mvprintw(8, 6, "Running into your own body costs a life, like a mine.");
+        mvprintw(9, 6, "Every %d people rescued: level up (faster, more mines).",
+                 PEOPLE_PER_LEVEL);
+    } else if (rules->body_as_lives) {
+        mvprintw(7, 6, "Your robot has multiple body segments = number of lives.");
+        mvprintw(8, 6, "Lose one life -> lose one segment.");
+        mvprintw(9, 6, "Every 5 levels you gain +1 extra life (segment).");
+    } else {
+        mvprintw(7, 6, "Every %d people rescued: level up (faster, more mines).",
+                 PEOPLE_PER_LEVEL);
+    }
+    mvprintw(10,6, "Rescue people, survive longer, and beat the high score!");
+
+    mvprintw(12, 4, "Controls:");
+    mvprintw(13, 6, "Arrow keys / WASD : move robot (Manual mode)");
+    mvprintw(14, 6, "'m'               : toggle Manual / AI mode");
+    mvprintw(15, 6, "'q'               : quit game");
+    if (rules->bomb) {
+        mvprintw(16, 6, "SPACE (level>10)  : spend 5 levels to bomb nearby mines");
+    }
+
+    mvprintw(18, 4, "Enter your name (max %d chars) and press ENTER:", MAX_NAME);
+}
+
+static void draw_name_field(const char *name) {
+    move(19, 4);
+    clrtoeol();
+    mvprintw(19, 4, "> %s", name);   // 光标停在名字后面
+    refresh();
+}
+
+static void draw_welcome(const Player *player) {
+    curs_set(0);
+    mvprintw(21, 4, "Welcome, %s! Press any key to start...", player->name);
+    refresh();
+}
+
+/* ================== 障碍物 ================== */
+
+static void draw_obstacle(WINDOW *board, const CrossObstacle *obstacle) {
+    wattron(board, COLOR_PAIR(CP_OBSTACLE));
+    for (int y = 1; y < BOARD_ROWS - 1; y++) {
+        for (int x = 1; x < BOARD_COLS - 1; x++) {
+            if (is_obstacle_position(obstacle, x, y)) {
+                mvwaddch(board, y, x, OBSTACLE);
+                cells_drawn++;
+            }
+        }
+    }
+    wattroff(board, COLOR_PAIR(CP_OBSTACLE));
+}
+
+/* ================== 棋盘初始化（向右侧靠） ================== */
+
+static WINDOW* init_game(void) {
+    int ymax, xmax;
+    getmaxyx(stdscr, ymax, xmax);
+
+    int start_y = (ymax - BOARD_ROWS) / 2;
+
+    /* 向右侧靠一点：保留右边 4 列空白 */
+    int right_margin = 20;
+    int start_x = xmax - BOARD_COLS - right_margin;
+    if (start_x < 0) start_x = 0;
+
+    WINDOW *board = newwin(BOARD_ROWS, BOARD_COLS, start_y, start_x);
+    wbkgd(board, COLOR_PAIR(CP_BOARD_BG));
+    werase(board);
+    box(board, 0, 0);
+
+    wrefresh(board);
+    return board;
+}
+
+/* ================== UI 状态栏 ================== */
+
+/* turbo_factor：当前速度倍数，1 不显示，0 显示 max */
+static void update_UI(const GameWorld *world, int turbo_factor) {
+    const Player *player = &world->player;
+    const Robot  *robot  = &world->robot;
+
+    int ymax, xmax;
+    getmaxyx(stdscr, ymax, xmax);
+    (void)ymax;
+
+    char rank_buf[16];
+    if (player->rank > 0) snprintf(rank_buf, sizeof(rank_buf), "#%d", player->rank);
+    else                  snprintf(rank_buf, sizeof(rank_buf), "--");
+
+    /* 快进时跟在模式后面，80 列终端也看得到 */
+    char speed_buf[16] = "";
+    if (turbo_factor == 0)     snprintf(speed_buf, sizeof(speed_buf), " max");
+    else if (turbo_factor > 1) snprintf(speed_buf, sizeof(speed_buf), " x%d", turbo_factor);
+
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "Player: %s  Score: %d  Rank: %s  Level: %d  Lives: %d  Mode: %s%s  Segments: %d",
+             player->name, player->score, rank_buf, player->level, player->lives,
+             robot->ai_mode ? "AI" : "Manual", speed_buf,
+             robot->body_length);
+
+    attron(COLOR_PAIR(CP_STATUS));
+    mvhline(0, 0, ' ', xmax);
+    mvprintw(0, 0, "%s", buf);
+
+    mvhline(1, 0, ' ', xmax);
+    if (world->rules->bomb)
+        mvprintw(1, 0, "Use Arrow keys/WASD to move. 'm' toggle AI, +/- speed, 'q' quit, SPACE bombs mines (lvl>10).");
+    else
+        mvprintw(1, 0, "Use Arrow keys/WASD to move. 'm' toggle AI, +/- speed, 'q' quit.");
+    attroff(COLOR_PAIR(CP_STATUS));
+
+    refresh();
+}
+
+/* ================== 输入处理（不含空格，空格在主循环单独处理） ================== */
+
+static void handle_input(Robot *robot, int input, bool *running) {
+    if (input == ERR) return;
+
+    switch (input) {
+        case 'q': case 'Q':
+            *running = false;
+            break;
+        case 'm': case 'M':
+            robot->ai_mode = !robot->ai_mode;
+            break;
+        case KEY_UP: case 'w': case 'W':
+            if (!robot->ai_mode) set_direction(robot, 'N');
+            break;
+        case KEY_DOWN: case 's': case 'S':
+            if (!robot->ai_mode) set_direction(robot, 'S');
+            break;
+        case KEY_LEFT: case 'a': case 'A':
+            if (!robot->ai_mode) set_direction(robot, 'W');
+            break;
+        case KEY_RIGHT: case 'd': case 'D':
+            if (!robot->ai_mode) set_direction(robot, 'E');
+            break;
+        default:
+            break;
+    }
+}
+
+/* ================== 地雷 / 人 / 机器人 绘制 ================== */
+
+static void draw_mines(WINDOW *board, const Position *mines, int mine_count) {
+    wattron(board, COLOR_PAIR(CP_MINE));
+    for (int i = 0; i < mine_count; i++) {
+        mvwaddch(board, mines[i].y, mines[i].x, MINE);
+    }
+    cells_drawn += mine_count;
+    wattroff(board, COLOR_PAIR(CP_MINE));
+}
+
+static void draw_people(WINDOW *board, const Position *people, int people_count) {
+    wattron(board, COLOR_PAIR(CP_PERSON));
+    for (int i = 0; i < people_count; i++) {
+        if (people[i].x < 0) continue;
+        mvwaddch(board, people[i].y, people[i].x, PERSON);
+        cells_drawn++;
+    }
+    wattroff(board, COLOR_PAIR(CP_PERSON));
+}
+
+static bool inside_board(Position p) {
+    return p.x > 0 && p.x < BOARD_COLS - 1 && p.y > 0 && p.y < BOARD_ROWS - 1;
+}
+
+static char head_char(char direction) {
+    switch (direction) {
+        case 'N': return '^';
+        case 'S': return 'v';
+        case 'W': return '<';
+        case 'E': return '>';
+        default:  return ROBOT_HEAD;
+    }
+}
+
+static void draw_robot(WINDOW *board, const Robot *robot) {
+    /* 无敌状态：闪烁效果（隔一帧显示/不显示） */
+    if (robot->invincible &&
+        (robot->invincible_ticks % 2 == 1)) {
+        return;
+    }
+
+    wattron(board, COLOR_PAIR(CP_ROBOT));
+
+    for (int i = 0; i < robot->body_length; i++) {
+        Position seg = robot_segment(robot, i);
+        if (inside_board(seg)) {
+            mvwaddch(board, seg.y, seg.x, ROBOT_BODY);
+        }
+    }
+
+    mvwaddch(board, robot->pos.y, robot->pos.x, head_char(robot->direction));
+    cells_drawn += 1 + robot->body_length;
+
+    wattroff(board, COLOR_PAIR(CP_ROBOT));
+}
+
+/* 普通的一步只改了三格：擦掉旧尾巴，旧头变成身体，画新头。
+ * 旧尾巴那格如果还压着别的身体（和自己重叠）就不擦；
+ * 身体底下可能有障碍（无敌时穿过去的）、后来刷出来的雷或人，擦完要补画 */
+static void draw_robot_step(WINDOW *board, const GameWorld *world, Position old_tail) {
+    const Robot *robot = &world->robot;
+
+    if (inside_board(old_tail) && !robot_body_at(robot, old_tail.x, old_tail.y)) {
+        if (is_obstacle_position(&world->obstacle, old_tail.x, old_tail.y)) {
+            mvwaddch(board, old_tail.y, old_tail.x, OBSTACLE | COLOR_PAIR(CP_OBSTACLE));
+        } else if (is_mine_at(world->mines, world->mine_count, old_tail.x, old_tail.y)) {
+            mvwaddch(board, old_tail.y, old_tail.x, MINE | COLOR_PAIR(CP_MINE));
+        } else if (find_person_at(world, old_tail.x, old_tail.y) >= 0) {
+            mvwaddch(board, old_tail.y, old_tail.x, PERSON | COLOR_PAIR(CP_PERSON));
+        } else {
+            mvwaddch(board, old_tail.y, old_tail.x, ' ' | COLOR_PAIR(CP_BOARD_BG));
+        }
+        cells_drawn++;
+    }
+
+    wattron(board, COLOR_PAIR(CP_ROBOT));
+    if (robot->body_length > 0) {
+        Position neck = robot_segment(robot, 0);
+        if (inside_board(neck)) {
+            mvwaddch(board, neck.y, neck.x, ROBOT_BODY);
+            cells_drawn++;
+        }
+    }
+    mvwaddch(board, robot->pos.y, robot->pos.x, head_char(robot->direction));
+    cells_drawn++;
+    wattroff(board, COLOR_PAIR(CP_ROBOT));
+}
+
+static void redraw_board(WINDOW *board, const GameWorld *world) {
+    werase(board);
+    box(board, 0, 0);
+    cells_drawn += 2 * (BOARD_ROWS + BOARD_COLS) - 4;
+    draw_obstacle(board, &world->obstacle);
+    draw_mines(board, world->mines, world->mine_count);
+    draw_people(board, world->people, world->people_count);
+    draw_robot(board, &world->robot);
+}
+
+/* ================== 炸弹：闪烁动画 + 删雷 ================== */
+
+#define BOMB_FLASH_FRAMES 6     // 闪烁 6 帧
+#define BOMB_FLASH_NS     80000000ull
+
+/* 标记要炸的雷；返回 true 表示要播动画，播完再 bomb_finish 删雷 */
+static bool bomb_start(GameWorld *world, bool marks[MAX_MINES]) {
+    if (!can_bomb(world)) return false;
+
+    TRACE_BEGIN("bomb");
+    memset(marks, 0, sizeof(bool) * MAX_MINES);
+    if (bomb_mark_mines(world, marks)) return true;
+
+    remove_marked_mines(world, marks);
+    TRACE_END("bomb");
+    return false;
+}
+
+static void bomb_draw_frame(const GameWorld *world, WINDOW *board,
+                            const bool marks[MAX_MINES], int frame, int turbo_factor) {
+    for (int i = 0; i < world->mine_count; i++) {
+        if (!marks[i]) continue;
+        char ch = (frame % 2 == 0) ? '*' : ' ';
+        mvwaddch(board, world->mines[i].y, world->mines[i].x, ch);
+    }
+    wrefresh(board);
+    update_UI(world, turbo_factor);
+}
+
+static void bomb_finish(GameWorld *world, const bool marks[MAX_MINES]) {
+    remove_marked_mines(world, marks);
+    TRACE_END("bomb");
+}
+
+/* ================== 排行榜 & Game Over ================== */
+
+/* 画面1 第 7 行：后台结果出来之前先显示占位文字 */
+static void draw_record_line(const LeaderboardUpdate *update, int xmax) {
+    const char *text;
+    if (!update->ready)          text = "Checking leaderboard...";
+    else if (update->new_record) text = "Congratulations! NEW HIGH SCORE!";
+    else                         text = "Nice run! Try to beat the record next time.";
+
+    move(7, 0);
+    clrtoeol();
+    mvprintw(7, (xmax - (int)strlen(text)) / 2, "%s", text);
+}
+
+/* 画面1：Game Over + 新纪录提示（后台结果出来前先显示占位） */
+static void draw_game_over(const Player *player, const LeaderboardUpdate *shown) {
+    clear();
+    int ymax, xmax;
+    getmaxyx(stdscr, ymax, xmax);
+
+    const char *msg = "GAME OVER";
+    mvprintw(2, (xmax - (int)strlen(msg)) / 2, "%s", msg);
+
+    char buf1[64];
+    snprintf(buf1, sizeof(buf1), "Final score: %d", player->score);
+    mvprintw(4, (xmax - (int)strlen(buf1)) / 2, "%s", buf1);
+
+    char buf2[64];
+    snprintf(buf2, sizeof(buf2), "Player: %s (Level %d)",
+             player->name, player->level);
+    mvprintw(5, (xmax - (int)strlen(buf2)) / 2, "%s", buf2);
+
+    draw_record_line(shown, xmax);
+
+    mvprintw(ymax - 3, (xmax - 36) / 2,
+             "Press any key to view leaderboard...");
+    refresh();
+}
+
+/* 画面2：排行榜布局 */
+static void draw_leaderboard(const LeaderboardUpdate *update) {
+    clear();
+    int ymax, xmax;
+    getmaxyx(stdscr, ymax, xmax);
+
+    const char *title = "LEADERBOARD - STATIC MINES MODE";
+    mvprintw(2, (xmax - (int)strlen(title)) / 2, "%s", title);
+
+    mvprintw(4, 4, "Rank  Name        Level  Score");
+    mvprintw(5, 4, "--------------------------------------");
+
+    if (update->top_count == 0) {
+        mvprintw(7, 6, "No records yet.");
+    } else {
+        for (int i = 0; i < update->top_count; i++) {
+            mvprintw(6 + i, 4, "%2d    %-10s  %5d  %5d",
+                     i + 1,
+                     update->top[i].name,
+                     update->top[i].level,
+                     update->top[i].score);
+        }
+    }
+    if (!update->saved) {
+        mvprintw(ymax - 3, 4, "(could not save %s)", LEADERBOARD_FILE);
+    }
+
+    mvprintw(ymax - 2, 4, "Press any key to exit.");
+    refresh();
+}
+
+/* ================== profiler HUD ================== */
+
+/* 状态栏下面一行：各阶段 p50/p99 */
+static void draw_profile_hud(const Profiler *prof) {
+    int ymax, xmax;
+    getmaxyx(stdscr, ymax, xmax);
+    (void)ymax;
+
+    char buf[256];
+    profiler_hud_line(prof, buf, sizeof(buf));
+
+    attron(COLOR_PAIR(CP_STATUS));
+    mvhline(2, 0, ' ', xmax);
+    mvprintw(2, 0, "%.*s", xmax, buf);
+    attroff(COLOR_PAIR(CP_STATUS));
+}
+
+/* ================== 快进基准：--turbo-bench ================== */
+
+/* 不睡眠、AI 自己玩 ticks 个 tick，整局结束就换个种子重开；
+ * every 个 tick 画一次（0 = 不画），返回每秒 tick 数 */
+static double bench_ticks(GameWorld *world, WINDOW *board, long ticks, long every) {
+    unsigned seed = 1;
+    world_reset(world, seed);
+    world->robot.ai_mode = true;
+
+    uint64_t t0 = profiler_now();
+    for (long t = 0; t < ticks; t++) {
+        bool running = true;
+        move_robot_ai(world);
+        move_robot(&world->robot);
+        check_collision(world, &running, NULL);
+        if (!running || world->player.lives <= 0) {
+            world_reset(world, ++seed);
+            world->robot.ai_mode = true;
+            continue;
+        }
+        handle_rescue(world);
+
+        if (every > 0 && t % every == 0) {
+            redraw_board(board, world);
+            update_UI(world, 0);
+            wrefresh(board);
+        }
+    }
+    return (double)ticks * 1e9 / (double)(profiler_now() - t0);
+}
+
+static int run_turbo_bench(const RuleSet *rules, long ticks) {
+    GameWorld *world = world_create(rules);
+    if (!world) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    snprintf(world->player.name, sizeof(world->player.name), "bench");
+
+    initscr();
+    cbreak();
+    noecho();
+    curs_set(0);
+    init_colors();
+    WINDOW *board = init_game();
+
+    double every_tick = bench_ticks(world, board, ticks, 1);
+    double decimated  = bench_ticks(world, board, ticks, 16);
+    double off        = bench_ticks(world, board, ticks, 0);
+
+    delwin(board);
+    endwin();
+    world_destroy(world);
+
+    printf("%s, %ld ticks per run, AI at unlimited speed\n", rules->name, ticks);
+    printf("  render every tick     %12.0f ticks/s\n", every_tick);
+    printf("  render every 16 ticks %12.0f ticks/s\n", decimated);
+    printf("  render off            %12.0f ticks/s\n", off);
+    return 0;
+}
+
+/* ================== 游戏流程状态机 ================== */
+
+/*
+ * 整个流程（输名字 → 游戏 → 掉命等 y → Game Over → 排行榜）是一个事件循环：
+ * 每轮在 getch 里最多等到当前状态的下一个定时器（下一个 tick、下一帧炸弹动画、
+ * 下一次看后台排行榜结果），来了按键就交给当前状态处理。
+ * 没有哪个状态会阻塞住循环，等玩家的时候定时器和后台结果照样处理。
+ */
+
+typedef enum {
+    STATE_TITLE,            // 输名字
+    STATE_WELCOME,          // 按任意键开始
+    STATE_PLAYING,
+    STATE_BOMB,             // 炸弹闪烁，游戏暂停
+    STATE_WAIT_CONTINUE,    // 掉命，等 y / q
+    STATE_GAME_OVER,        // 画面1，同时等后台排行榜结果
+    STATE_LEADERBOARD,      // 画面2
+    STATE_EXIT
+} GameState;
+
+#define POLL_NS 50000000ull     // 等后台结果时的轮询间隔
+
+typedef struct {
+    GameState  state;
+    uint64_t   deadline;        // 当前状态的下一个定时器（ns）；0 = 没有，只等按键
+
+    const RuleSet *rules;
+    GameWorld *world;
+    WINDOW    *board;
+    RankTable  ranks;
+    Profiler  *prof;
+    bool       show_profile;
+    int        turbo_idx;
+    int        turbo_factor;    // TURBO_STEPS[turbo_idx]
+    uint64_t   last_render;
+    bool       board_dirty;     // 下一次要整张重画（开局、救人、炸弹、抽帧跳过之后）
+
+    char       name[MAX_NAME + 1];
+    int        name_len;
+
+    bool       bomb_marks[MAX_MINES];
+    int        bomb_frame;
+
+    LeaderboardUpdate update;   // 后台线程写
+    LeaderboardUpdate shown;    // 画面上正在显示的
+    bool       leave_game_over; // Game Over 画面已经按过键，后台写完就翻到排行榜
+} CursesGame;
+
+static void enter_game_over(CursesGame *g) {
+    /* 成绩交给后台线程读/排序/写盘，画面直接用内存里的数据先显示 */
+    const Player *player = &g->world->player;
+    LeaderboardEntry entry;
+    strncpy(entry.name, player->name, MAX_NAME);
+    entry.name[MAX_NAME] = '\0';
+    entry.score = player->score;
+    entry.level = player->level;
+    leaderboard_submit(LEADERBOARD_FILE, &entry, &g->update);
+
+    memset(&g->shown, 0, sizeof(g->shown));
+    draw_game_over(player, &g->shown);
+    g->leave_game_over = false;
+    g->state    = STATE_GAME_OVER;
+    g->deadline = profiler_now() + POLL_NS;
+}
+
+/* 一个 tick 的内容：AI → 移动 → 碰撞 → 救人 → 画；中途可以直接 return */
+static void tick_body(CursesGame *g) {
+    GameWorld *world  = g->world;
+    Player    *player = &world->player;
+    Robot     *robot  = &world->robot;
+    Profiler  *prof   = g->prof;
+
+    profiler_begin(prof, PHASE_AI);
+    unsigned long bfs_before = world->bfs_nodes;
+    if (robot->ai_mode) {
+        move_robot_ai(world);
+    }
+    profiler_add(prof, COUNTER_BFS_NODES, world->bfs_nodes - bfs_before);
+    profiler_end(prof, PHASE_AI);
+
+    profiler_begin(prof, PHASE_MOVE);
+    cells_drawn = 0;
+    Position old_tail = robot_tail(robot);
+    move_robot(robot);
+    profiler_end(prof, PHASE_MOVE);
+
+    profiler_begin(prof, PHASE_COLLISION);
+    bool running = true, life_lost = false;
+    check_collision(world, &running, &life_lost);
+    profiler_end(prof, PHASE_COLLISION);
+    if (!running || player->lives <= 0) {
+        enter_game_over(g);
+        return;
+    }
+
+    /* 如果刚刚掉命：提示按 y 继续 */
+    if (life_lost) {
+        profiler_begin(prof, PHASE_RENDER);
+        redraw_board(g->board, world);
+        update_UI(world, g->turbo_factor);
+        if (g->show_profile) draw_profile_hud(prof);
+
+        int ymax, xmax;
+        getmaxyx(stdscr, ymax, xmax);
+        (void)xmax;
+        mvprintw(ymax - 1, 4,
+                 "You lost a life! Press 'y' to continue or 'q' to quit.");
+        refresh();
+        wrefresh(g->board);
+        profiler_end(prof, PHASE_RENDER);
+        profiler_add(prof, COUNTER_CELLS_REDRAWN, cells_drawn);
+
+        g->state    = STATE_WAIT_CONTINUE;
+        g->deadline = 0;            // 等按键的时间不算进任何阶段
+        return;
+    }
+
+    /* 救人逻辑 */
+    profiler_begin(prof, PHASE_RESCUE);
+    if (handle_rescue(world)) {
+        player->rank = rank_table_rank(&g->ranks, player->score);
+        g->board_dirty = true;      // 人、雷、身体都可能变了
+    }
+    profiler_end(prof, PHASE_RESCUE);
+
+    /* 画棋盘：平时只画变了的几格；快进时按墙钟抽帧，模拟照常每个 tick 都跑 */
+    uint64_t now = profiler_now();
+    if (g->turbo_factor == 1 || now - g->last_render >= RENDER_INTERVAL_NS) {
+        g->last_render = now;
+        profiler_begin(prof, PHASE_RENDER);
+        if (g->board_dirty || robot->invincible) {
+            redraw_board(g->board, world);
+            g->board_dirty = false;
+        } else {
+            draw_robot_step(g->board, world, old_tail);
+        }
+
+        update_UI(world, g->turbo_factor);
+        if (g->show_profile) draw_profile_hud(prof);
+        TRACE_BEGIN("present");
+        wrefresh(g->board);
+        TRACE_END("present");
+        profiler_end(prof, PHASE_RENDER);
+    } else {
+        g->board_dirty = true;      // 跳过的几步没画，下次整张重画
+    }
+    profiler_add(prof, COUNTER_CELLS_REDRAWN, cells_drawn);
+
+    int delay_ms = get_delay_for_level(g->rules, player->level);
+    if (g->turbo_factor == 0)     delay_ms = 0;
+    else if (g->turbo_factor > 1) delay_ms /= g->turbo_factor;
+    g->deadline = profiler_now() + (uint64_t)delay_ms * 1000000ull;
+}
+
+/* 一帧 = 一个 tick，不管从哪里出来都只在这里收尾；不在游戏中的状态不算帧 */
+static void play_tick(CursesGame *g) {
+    TRACE_BEGIN("tick");
+    profiler_frame_begin(g->prof);
+    tick_body(g);
+    profiler_frame_end(g->prof);
+    TRACE_END("tick");
+}
+
+static void play_key(CursesGame *g, int ch) {
+    Profiler *prof = g->prof;
+    bool running = true;
+
+    profiler_begin(prof, PHASE_INPUT);
+    /* 空格：炸弹技能（level>10） */
+    if (ch == ' ') {
+        if (bomb_start(g->world, g->bomb_marks)) {
+            g->bomb_frame = 0;
+            bomb_draw_frame(g->world, g->board, g->bomb_marks, 0, g->turbo_factor);
+            g->state    = STATE_BOMB;
+            g->deadline = profiler_now() + BOMB_FLASH_NS;
+        }
+    } else if (ch == '+' || ch == '=') {
+        if (g->turbo_idx < TURBO_STEP_COUNT - 1) g->turbo_factor = TURBO_STEPS[++g->turbo_idx];
+    } else if (ch == '-' || ch == '_') {
+        if (g->turbo_idx > 0) g->turbo_factor = TURBO_STEPS[--g->turbo_idx];
+    } else if (prof && (ch == 'p' || ch == 'P')) {
+        g->show_profile = !g->show_profile;
+        if (!g->show_profile) {
+            move(2, 0);
+            clrtoeol();
+        }
+    } else {
+        handle_input(&g->world->robot, ch, &running);
+    }
+    profiler_end(prof, PHASE_INPUT);
+
+    if (!running) enter_game_over(g);
+}
+
+/* 后台排行榜已经写完才调用 */
+static void show_leaderboard(CursesGame *g) {
+    draw_leaderboard(&g->update);
+    g->state    = STATE_LEADERBOARD;
+    g->deadline = 0;
+}
+
+static void on_key(CursesGame *g, int ch) {
+    switch (g->state) {
+        case STATE_TITLE:
+            if (ch == '\n' || ch == '\r' || ch == KEY_ENTER) {
+                Player *player = &g->world->player;
+                if (g->name_len == 0) strcpy(player->name, "Player");
+                else snprintf(player->name, sizeof(player->name), "%s", g->name);
+                draw_welcome(player);
+                g->state = STATE_WELCOME;
+            } else if (ch == KEY_BACKSPACE || ch == 127 || ch == '\b') {
+                if (g->name_len > 0) g->name[--g->name_len] = '\0';
+                draw_name_field(g->name);
+            } else if (ch >= 32 && ch <= 126 && g->name_len < MAX_NAME) {
+                g->name[g->name_len++] = (char)ch;
+                g->name[g->name_len] = '\0';
+                draw_name_field(g->name);
+            }
+            break;
+
+        case STATE_WELCOME:
+            g->board = init_game();
+            world_reset(g->world, (unsigned int)time(NULL));
+            g->state       = STATE_PLAYING;
+            g->deadline    = profiler_now();
+            g->board_dirty = true;
+            break;
+
+        case STATE_PLAYING:
+            play_key(g, ch);
+            break;
+
+        case STATE_BOMB:
+            break;                  // 动画期间不收按键
+
+        case STATE_WAIT_CONTINUE:
+            if (ch == 'y' || ch == 'Y') {
+                int ymax, xmax;
+                getmaxyx(stdscr, ymax, xmax);
+                (void)xmax;
+                move(ymax - 1, 0);
+                clrtoeol();
+                g->state    = STATE_PLAYING;
+                g->deadline = profiler_now();
+            } else if (ch == 'q' || ch == 'Q') {
+                enter_game_over(g);
+            }
+            break;
+
+        case STATE_GAME_OVER:
+            /* 后台还没写完就先记下按键，由定时器那边等它写完再翻页，输入这里不阻塞 */
+            if (leaderboard_update_ready(&g->update)) {
+                show_leaderboard(g);
+            } else {
+                g->leave_game_over = true;
+                if (!g->deadline) g->deadline = profiler_now() + POLL_NS;
+            }
+            break;
+
+        case STATE_LEADERBOARD:
+            g->state = STATE_EXIT;
+            break;
+
+        case STATE_EXIT:
+            break;
+    }
+}
+
+static void on_timer(CursesGame *g) {
+    switch (g->state) {
+        case STATE_PLAYING:
+            play_tick(g);
+            break;
+
+        case STATE_BOMB:
+            if (++g->bomb_frame < BOMB_FLASH_FRAMES) {
+                bomb_draw_frame(g->world, g->board, g->bomb_marks, g->bomb_frame,
+                                g->turbo_factor);
+                g->deadline += BOMB_FLASH_NS;
+            } else {
+                bomb_finish(g->world, g->bomb_marks);
+                g->board_dirty = true;
+                g->state    = STATE_PLAYING;
+                g->deadline = profiler_now();   // 接着跑被打断的这个 tick
+            }
+            break;
+
+        case STATE_GAME_OVER:
+            /* 轮询后台结果，好了就补上新纪录提示 */
+            if (leaderboard_update_ready(&g->update)) {
+                int ymax, xmax;
+                getmaxyx(stdscr, ymax, xmax);
+                (void)ymax;
+                g->shown = g->update;
+                draw_record_line(&g->shown, xmax);
+                refresh();
+                g->deadline = 0;
+                if (g->leave_game_over) show_leaderboard(g);
+            } else {
+                g->deadline += POLL_NS;
+            }
+            break;
+
+        default:
+            g->deadline = 0;
+            break;
+    }
+}
+
+/* ================== 主循环 ================== */
+
+int run_curses_game(const RuleSet *rules, int argc, char **argv) {
+    /* 命令行查询排行榜，不进入游戏 */
+    if (argc > 1 && strcmp(argv[1], "--leaderboard") == 0) {
+        return leaderboard_cli(argc - 2, argv + 2);
+    }
+
+    /* --turbo-bench [TICKS]：不进游戏，测不限速时画面开/关的 tick 速率 */
+    if (argc > 1 && strcmp(argv[1], "--turbo-bench") == 0) {
+        long ticks = argc > 2 ? atol(argv[2]) : 20000;
+        return run_turbo_bench(rules, ticks > 0 ? ticks : 20000);
+    }
+
+    /* --profile [FILE]：分阶段计时，退出时写报告；游戏中按 p 显示/隐藏 HUD
+     * --perf：再加上每阶段的硬件计数器（隐含 --profile）
+     * --turbo N：开局速度倍数（1/2/4/8/16，max = 不限速），游戏中 +/- 调
+     * --people K：同时有 K 个人可救（默认 1，最多 MAX_PEOPLE） */
+    const char *profile_path = NULL;
+    const char *trace_path   = NULL;   // --trace FILE：Chrome trace-event JSON
+    bool want_perf = false;
+    int turbo_idx = 0;
+    int people = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0) {
+            profile_path = (i + 1 < argc && argv[i + 1][0] != '-')
+                         ? argv[++i] : "profile.txt";
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            want_perf = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--people") == 0 && i + 1 < argc) {
+            people = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--turbo") == 0 && i + 1 < argc) {
+            const char *arg = argv[++i];
+            int want = strcmp(arg, "max") == 0 ? 0 : atoi(arg);
+            for (int k = 0; k < TURBO_STEP_COUNT; k++) {
+                if (TURBO_STEPS[k] == want) turbo_idx = k;
+            }
+        }
+    }
+    if (want_perf && !profile_path) profile_path = "profile.txt";
+    Profiler *prof = profile_path ? profiler_create() : NULL;
+    if (prof && want_perf && !profiler_enable_perf(prof)) {
+        /* 没有 PMU 或没权限：只是少了计数器，照样玩 */
+        fprintf(stderr, "perf counters unavailable (%s), timing only\n",
+                prof->perf_error);
+    }
+    if (trace_path) {
+        trace_start();
+        trace_thread_name("main");
+    }
+
+    leaderboard_writer_start();
+
+    initscr();
+    cbreak();
+    noecho();
+    keypad(stdscr, TRUE);
+    init_colors();
+
+    /* 整局状态只分配这一次 */
+    CursesGame g;
+    memset(&g, 0, sizeof(g));
+    g.rules     = rules;
+    g.prof      = prof;
+    g.turbo_idx = turbo_idx;
+    g.turbo_factor = TURBO_STEPS[turbo_idx];
+    g.world     = world_create(rules);
+    if (!g.world) {
+        endwin();
+        leaderboard_writer_stop();
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    world_set_people(g.world, people);
+    Player *player = &g.world->player;
+
+    /* 玩家输名字的时候后台把排行榜分数读进来 */
+    rank_table_load_async(&g.ranks, LEADERBOARD_FILE);
+
+    g.state = STATE_TITLE;
+    draw_title_screen(rules);
+    curs_set(1);
+    draw_name_field(g.name);
+
+    while (g.state != STATE_EXIT) {
+        /* 在 getch 里等到下一个定时器；没有定时器就一直等按键 */
+        int wait_ms = -1;
+        if (g.deadline) {
+            uint64_t now = profiler_now();
+            wait_ms = g.deadline > now ? (int)((g.deadline - now + 999999) / 1000000) : 0;
+        }
+
+        bool sleeping = g.state == STATE_PLAYING;
+        if (sleeping) profiler_begin(prof, PHASE_SLEEP);
+        timeout(wait_ms);
+        int ch = getch();
+        if (sleeping) profiler_end(prof, PHASE_SLEEP);
+
+        /* 排行榜刚读完：先算一次名次 */
+        if (player->rank == 0 && rank_table_ready(&g.ranks)) {
+            player->rank = rank_table_rank(&g.ranks, player->score);
+        }
+
+        if (ch != ERR) on_key(&g, ch);
+        if (g.deadline && profiler_now() >= g.deadline) on_timer(&g);
+    }
+
+    if (g.board) delwin(g.board);
+    world_destroy(g.world);
+    leaderboard_writer_stop();   // 排队中的成绩全部落盘后再退出
+    rank_table_free(&g.ranks);
+    endwin();
+
+    if (prof) {
+        if (!profiler_dump(prof, profile_path))
+            fprintf(stderr, "could not write %s\n", profile_path);
+        profiler_destroy(prof);
+    }
+    if (trace_path && !trace_write(trace_path)) {
+        fprintf(stderr, "could not write %s\n", trace_path);
+    }
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef CURSES_FRONTEND_H
+#define CURSES_FRONTEND_H
+
+#include "engine.h"
+
+/* ================== ncurses 前端 ================== */
+
+/*
+ * 标题、棋盘绘制、输入、Game Over 和排行榜界面。
+ * 规则全部来自 rules，各 game_modelN.c 只是用不同的 RuleSet 调用它。
+ * 支持 --leaderboard 命令行查询（见 leaderboard.h）。
+ */
+int run_curses_game(const RuleSet *rules, int argc, char **argv);
+
+#endif
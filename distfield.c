@@ -0,0 +1,266 @@
+#include "distfield.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* 四个邻格，出界的是 -1 */
+static void neighbors(const DistField *df, int c, int out[4]) {
+    int x = c % df->w, y = c / df->w;
+    out[0] = x + 1 < df->w ? c + 1 : -1;
+    out[1] = x > 0 ? c - 1 : -1;
+    out[2] = y + 1 < df->h ? c + df->w : -1;
+    out[3] = y > 0 ? c - df->w : -1;
+}
+
+/* ================== 创建 / 销毁 ================== */
+
+DistField *distfield_create(int w, int h) {
+    DistField *df = calloc(1, sizeof(DistField));
+    if (!df) return NULL;
+
+    df->w = w;
+    df->h = h;
+    df->cells = w * h;
+    size_t n = (size_t)df->cells;
+    df->dist    = malloc(n * sizeof(unsigned short));
+    df->blocked = malloc(n);
+    df->source  = malloc(n);
+    df->mark    = calloc(n, sizeof(unsigned int));
+    df->list    = malloc(n * sizeof(int));
+    df->queue   = malloc(n * sizeof(int));
+    df->seeds   = malloc(n * sizeof(unsigned long long));
+    if (!df->dist || !df->blocked || !df->source || !df->mark ||
+        !df->list || !df->queue || !df->seeds) {
+        distfield_destroy(df);
+        return NULL;
+    }
+    distfield_reset(df);
+    return df;
+}
+
+void distfield_destroy(DistField *df) {
+    if (!df) return;
+    free(df->dist);
+    free(df->blocked);
+    free(df->source);
+    free(df->mark);
+    free(df->list);
+    free(df->queue);
+    free(df->seeds);
+    free(df);
+}
+
+void distfield_reset(DistField *df) {
+    memset(df->blocked, 0, (size_t)df->cells);
+    memset(df->source, 0, (size_t)df->cells);
+    df->sources = 0;
+    df->valid = false;
+}
+
+/* ================== 整张重算 ================== */
+
+unsigned long distfield_rebuild(DistField *df) {
+    int *queue = df->queue;
+    int front = 0, back = 0;
+
+    for (int c = 0; c < df->cells; c++) {
+        df->dist[c] = DF_INF;
+        if (df->source[c] && !df->blocked[c]) {
+            df->dist[c] = 0;
+            queue[back++] = c;
+        }
+    }
+
+    while (front < back) {
+        int c = queue[front++];
+        unsigned short next = df->dist[c] + 1;
+        int nb[4];
+        neighbors(df, c, nb);
+        for (int k = 0; k < 4; k++) {
+            int n = nb[k];
+            if (n < 0 || df->blocked[n] || df->dist[n] <= next) continue;
+            df->dist[n] = next;
+            queue[back++] = n;
+        }
+    }
+
+    df->valid = true;
+    return (unsigned long)front;
+}
+
+/* ================== 增量修场 ================== */
+
+/* 按邻格算出来的值：源点是 0，否则最小的有效邻格 + 1 */
+static unsigned short support(const DistField *df, int c) {
+    if (df->source[c]) return 0;
+    unsigned short best = DF_INF;
+    int nb[4];
+    neighbors(df, c, nb);
+    for (int k = 0; k < 4; k++) {
+        int n = nb[k];
+        if (n < 0 || df->blocked[n]) continue;
+        if (df->dist[n] < best) best = df->dist[n];
+    }
+    return best == DF_INF ? DF_INF : best + 1;
+}
+
+/* c 的值可能变小了：从它往外推，只有真变小的格子入队 */
+static unsigned long lower(DistField *df, int c) {
+    unsigned short v = support(df, c);
+    if (v >= df->dist[c]) return 1;
+    df->dist[c] = v;
+
+    int *queue = df->queue;
+    int front = 0, back = 0;
+    queue[back++] = c;
+    while (front < back) {
+        int cur = queue[front++];
+        unsigned short next = df->dist[cur] + 1;
+        int nb[4];
+        neighbors(df, cur, nb);
+        for (int k = 0; k < 4; k++) {
+            int n = nb[k];
+            if (n < 0 || df->blocked[n] || df->dist[n] <= next) continue;
+            df->dist[n] = next;
+            queue[back++] = n;
+        }
+    }
+    return (unsigned long)front;
+}
+
+static int compare_seed(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long *)a;
+    unsigned long long y = *(const unsigned long long *)b;
+    return (x > y) - (x < y);
+}
+
+/* k 还有没有失效区域以外的"上家"（dist 正好小 1 的通路邻格） */
+static bool has_parent(const DistField *df, int k, unsigned int stamp) {
+    int nb[4];
+    neighbors(df, k, nb);
+    for (int j = 0; j < 4; j++) {
+        int m = nb[j];
+        if (m < 0 || df->blocked[m] || df->mark[m] == stamp) continue;
+        if (df->dist[m] + 1 == df->dist[k]) return true;
+    }
+    return false;
+}
+
+/* c 失去了原来的值（被挡住或者不再是源点），靠它的格子都要重算 */
+static unsigned long raise(DistField *df, int c) {
+    if (df->dist[c] == DF_INF) return 1;     // 本来就走不到，没人靠它
+
+    if (++df->stamp == 0) {
+        memset(df->mark, 0, sizeof(unsigned int) * (size_t)df->cells);
+        df->stamp = 1;
+    }
+    unsigned int stamp = df->stamp;
+
+    /* 1. 找失效区域：只靠失效格子当上家的格子也失效。
+     *    先判有上家、后来上家失效的格子，会在上家出队时被重新检查 */
+    int *list = df->list;
+    int n_list = 0;
+    df->mark[c] = stamp;
+    list[n_list++] = c;
+    for (int i = 0; i < n_list; i++) {
+        int x = list[i];
+        int nb[4];
+        neighbors(df, x, nb);
+        for (int k = 0; k < 4; k++) {
+            int n = nb[k];
+            if (n < 0 || df->blocked[n] || df->source[n] || df->mark[n] == stamp) continue;
+            if (df->dist[n] != df->dist[x] + 1) continue;
+            if (has_parent(df, n, stamp)) continue;
+            df->mark[n] = stamp;
+            list[n_list++] = n;
+        }
+        /* 失效了一大片（比如唯一的一个人被救走），局部修补不比整张重算省，直接重算 */
+        if (n_list > df->cells / 4) return (unsigned long)n_list + distfield_rebuild(df);
+    }
+
+    /* 2. 失效区域清成走不到，再从边界上的有效格子取第一批值 */
+    for (int i = 0; i < n_list; i++) df->dist[list[i]] = DF_INF;
+
+    int n_seeds = 0;
+    for (int i = 0; i < n_list; i++) {
+        int x = list[i];
+        if (df->blocked[x]) continue;
+        unsigned short v = support(df, x);
+        if (v == DF_INF) continue;
+        df->dist[x] = v;
+        df->seeds[n_seeds++] = (unsigned long long)v << 32 | (unsigned int)x;
+    }
+    qsort(df->seeds, (size_t)n_seeds, sizeof(unsigned long long), compare_seed);
+
+    /* 3. 两路合并的 BFS：排好序的种子和队列谁小先出，相当于单位边权的 Dijkstra */
+    int *queue = df->queue;
+    int front = 0, back = 0, s = 0;
+    unsigned long pops = 0;
+    while (s < n_seeds || front < back) {
+        int cur;
+        if (s < n_seeds &&
+            (front == back || (df->seeds[s] >> 32) <= df->dist[queue[front]])) {
+            unsigned long long seed = df->seeds[s++];
+            cur = (int)(seed & 0xffffffffu);
+            if (df->dist[cur] < (seed >> 32)) continue;  // 已经被推到更小了
+        } else {
+            cur = queue[front++];
+        }
+        pops++;
+
+        unsigned short next = df->dist[cur] + 1;
+        int nb[4];
+        neighbors(df, cur, nb);
+        for (int k = 0; k < 4; k++) {
+            int n = nb[k];
+            if (n < 0 || df->blocked[n] || df->dist[n] <= next) continue;
+            df->dist[n] = next;
+            queue[back++] = n;
+        }
+    }
+    return (unsigned long)n_list + pops;
+}
+
+/* ================== 对外接口 ================== */
+
+unsigned long distfield_block(DistField *df, int x, int y) {
+    int c = y * df->w + x;
+    if (df->blocked[c]++ > 0 || !df->valid) return 0;
+    return raise(df, c);
+}
+
+unsigned long distfield_unblock(DistField *df, int x, int y) {
+    int c = y * df->w + x;
+    if (df->blocked[c] == 0 || --df->blocked[c] > 0 || !df->valid) return 0;
+    df->dist[c] = DF_INF;
+    return lower(df, c);
+}
+
+unsigned long distfield_add_source(DistField *df, int x, int y) {
+    int c = y * df->w + x;
+    if (df->source[c]++ > 0) return 0;
+    df->sources++;
+    if (!df->valid || df->blocked[c]) return 0;
+    return lower(df, c);
+}
+
+unsigned long distfield_remove_source(DistField *df, int x, int y) {
+    int c = y * df->w + x;
+    if (df->source[c] == 0 || --df->source[c] > 0) return 0;
+    df->sources--;
+    if (!df->valid || df->blocked[c]) return 0;
+    return raise(df, c);
+}
+
+unsigned long distfield_move_source(DistField *df, int fx, int fy, int tx, int ty) {
+    int from = fy * df->w + fx;
+    if (df->valid && df->sources == 1 && df->source[from] == 1) {
+        df->valid = false;
+        distfield_remove_source(df, fx, fy);
+        distfield_add_source(df, tx, ty);
+        return distfield_rebuild(df);
+    }
+    /* 先加后撤：撤的时候新源点已经在了，失效的只是离旧位置更近的那一片 */
+    unsigned long work = distfield_add_source(df, tx, ty);
+    return work + distfield_remove_source(df, fx, fy);
+}
@@ -0,0 +1,67 @@
+#ifndef DISTFIELD_H
+#define DISTFIELD_H
+
+#include <stdbool.h>
+
+/* ================== 增量维护的"到最近的人"距离场 ================== */
+
+/*
+ * dist[c] = 从格子 c 走到最近一个人（源点）要几步，走不到 / 被挡住是 DF_INF。
+ * 机器人每一步只要看四个邻格里谁的 dist 最小，O(1)。
+ *
+ * 场景变化时不整张重算，只修受影响的那一片（单位边权下的 LPA* / D* Lite）：
+ *   - 变好（雷被炸掉、新刷出一个人）：从那一格往外 BFS，
+ *     只有 dist 真的变小的格子才入队；
+ *   - 变坏（加雷、人被救走）：先找出最短路必须经过那一格的格子
+ *     （邻格里再也找不到 dist - 1 的"上家"），把它们标成失效，
+ *     再从失效区域边界上还有效的格子按 dist 从小到大往里推。
+ * 两种情况碰到的格子数都和变化影响的范围成正比，和棋盘大小无关。
+ *
+ * blocked / source 都是计数，同一格被挡两次要放开两次才算通。
+ * distfield_reset 之后到 distfield_rebuild 之前只记数、不修场，
+ * 给开局时一口气摆雷、摆人用。
+ */
+
+#define DF_INF 0xFFFF
+
+typedef struct {
+    int w;
+    int h;
+    int cells;
+
+    unsigned short *dist;
+    unsigned char  *blocked;
+    unsigned char  *source;
+    int             sources;    // 有几格是源点
+    bool            valid;      // false：reset 之后还没 rebuild
+
+    /* 修场用的临时数组，都是 cells 大小 */
+    unsigned int   *mark;       // 失效标记，按 stamp 比较
+    unsigned int    stamp;
+    int            *list;       // 失效格子
+    int            *queue;
+    unsigned long long *seeds;  // 失效区域里第一批有值的格子：dist << 32 | 格子，排序后从小到大
+} DistField;
+
+DistField *distfield_create(int w, int h);
+void       distfield_destroy(DistField *df);
+
+/* 全部清空：没墙没人，场失效 */
+void distfield_reset(DistField *df);
+/* 按当前的 blocked / source 整张 BFS 一遍，场生效；返回展开的格子数 */
+unsigned long distfield_rebuild(DistField *df);
+
+/* 下面四个返回这次修场碰到的格子数（场失效时只记数，返回 0） */
+unsigned long distfield_block(DistField *df, int x, int y);
+unsigned long distfield_unblock(DistField *df, int x, int y);
+unsigned long distfield_add_source(DistField *df, int x, int y);
+unsigned long distfield_remove_source(DistField *df, int x, int y);
+/* 源点从 (fx, fy) 挪到 (tx, ty)。场上只有这一个源点时整张都会变，直接重算 */
+unsigned long distfield_move_source(DistField *df, int fx, int fy, int tx, int ty);
+
+static inline unsigned short distfield_at(const DistField *df, int x, int y) {
+    if (x < 0 || x >= df->w || y < 0 || y >= df->h) return DF_INF;
+    return df->dist[y * df->w + x];
+}
+
+#endif
@@ -0,0 +1,940 @@
+#include "engine.h"
+#include "trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ================== 各版本的规则 ================== */
+
+const RuleSet RULES_MODEL1 = {
+    .name = "model1", .ai = AI_GREEDY, .speed = SPEED_LINEAR,
+    .base_delay_ms = 200, .level_speedup_ms = 20, .min_delay_ms = 60,
+    .body_as_lives = false, .safe_spawn = false, .bomb = false,
+    .start_in_ai = false,
+};
+
+const RuleSet RULES_MODEL2 = {
+    .name = "model2", .ai = AI_GREEDY, .speed = SPEED_LINEAR,
+    .base_delay_ms = 200, .level_speedup_ms = 20, .min_delay_ms = 60,
+    .body_as_lives = false, .safe_spawn = false, .bomb = false,
+    .start_in_ai = true,
+};
+
+const RuleSet RULES_MODEL3 = {
+    .name = "model3", .ai = AI_BFS, .speed = SPEED_LINEAR,
+    .base_delay_ms = 200, .level_speedup_ms = 20, .min_delay_ms = 60,
+    .body_as_lives = false, .safe_spawn = false, .bomb = false,
+    .start_in_ai = true,
+};
+
+const RuleSet RULES_MODEL4 = {
+    .name = "model4", .ai = AI_BFS, .speed = SPEED_LINEAR,
+    .base_delay_ms = 200, .level_speedup_ms = 20, .min_delay_ms = 60,
+    .body_as_lives = true, .safe_spawn = false, .bomb = false,
+    .start_in_ai = true,
+};
+
+const RuleSet RULES_MODEL5 = {
+    .name = "model5", .ai = AI_BFS, .speed = SPEED_HALVING,
+    .base_delay_ms = 400, .level_speedup_ms = 0, .min_delay_ms = 50,
+    .body_as_lives = true, .safe_spawn = true, .bomb = false,
+    .start_in_ai = true,
+};
+
+const RuleSet RULES_MODEL6 = {
+    .name = "model6", .ai = AI_BFS, .speed = SPEED_HALVING,
+    .base_delay_ms = 400, .level_speedup_ms = 0, .min_delay_ms = 50,
+    .body_as_lives = true, .safe_spawn = true, .bomb = true,
+    .start_in_ai = true,
+};
+
+const RuleSet RULES_CLASSIC = {
+    .name = "classic", .ai = AI_BFS, .speed = SPEED_LINEAR,
+    .base_delay_ms = 150, .level_speedup_ms = 10, .min_delay_ms = 60,
+    .body_as_lives = false, .safe_spawn = true, .bomb = false,
+    .start_in_ai = true, .growth = true,
+};
+
+/* ================== 方向工具 ================== */
+
+void set_direction(Robot *robot, char dir) {
+    robot->direction = dir;
+}
+
+void direction_to_delta(char dir, int *dx, int *dy) {
+    *dx = 0; *dy = 0;
+    switch (dir) {
+        case 'N': *dx = 0;  *dy = -1; break;
+        case 'S': *dx = 0;  *dy = 1;  break;
+        case 'W': *dx = -1; *dy = 0;  break;
+        case 'E': *dx = 1;  *dy = 0;  break;
+        default:  *dx = 0;  *dy = 0;  break;
+    }
+}
+
+void init_player(Player *player) {
+    player->score   = 0;
+    player->lives   = INITIAL_LIVES;
+    player->level   = 1;
+    player->rescued = 0;
+    player->rank    = 0;
+}
+
+/* ================== 障碍物 ================== */
+
+void init_obstacle(CrossObstacle *obstacle) {
+    obstacle->width    = 11;
+    obstacle->height   = 11;
+    obstacle->center_x = BOARD_COLS / 2;
+    obstacle->center_y = BOARD_ROWS / 2;
+}
+
+bool is_obstacle_position(const CrossObstacle *obstacle, int x, int y) {
+    int cx = obstacle->center_x;
+    int cy = obstacle->center_y;
+    int half_w = obstacle->width  / 2;
+    int half_h = obstacle->height / 2;
+
+    if (y == cy && x >= cx - half_w && x <= cx + half_w) return true;
+    if (x == cx && y >= cy - half_h && y <= cy + half_h) return true;
+    return false;
+}
+
+/* ================== 地雷辅助 ================== */
+
+bool is_mine_at(const Position *mines, int mine_count, int x, int y) {
+    for (int i = 0; i < mine_count; i++) {
+        if (mines[i].x == x && mines[i].y == y) return true;
+    }
+    return false;
+}
+
+bool is_blocked_cell(int x, int y,
+                     const Position *mines, int mine_count,
+                     const CrossObstacle *obstacle) {
+    if (x <= 0 || x >= BOARD_COLS - 1 ||
+        y <= 0 || y >= BOARD_ROWS - 1)
+        return true;
+    if (is_obstacle_position(obstacle, x, y)) return true;
+    if (is_mine_at(mines, mine_count, x, y)) return true;
+    return false;
+}
+
+/* ================== 出生点 ================== */
+
+/* 安全出生点：尽量靠近 (10,10) */
+Position find_safe_spawn_position(const Position *mines, int mine_count,
+                                  const CrossObstacle *obstacle) {
+    int target_x = 10;
+    int target_y = 10;
+
+    Position best = {BOARD_COLS / 2, BOARD_ROWS / 2};
+    int best_dist = 1000000;
+
+    for (int y = 2; y < BOARD_ROWS - 2; y++) {
+        for (int x = 2; x < BOARD_COLS - 2; x++) {
+            if (is_obstacle_position(obstacle, x, y)) continue;
+            if (mines && is_mine_at(mines, mine_count, x, y)) continue;
+
+            int dist = abs(x - target_x) + abs(y - target_y);
+            if (dist < best_dist) {
+                best_dist = dist;
+                best.x = x;
+                best.y = y;
+            }
+        }
+    }
+    return best;
+}
+
+/* 距离表：后台已经按当前的图算好才用，没算好返回 NULL（不等） */
+static const DistOracle *fresh_oracle(GameWorld *world) {
+    if (!world->oracle || !oracle_ready(world->oracle)) return NULL;
+    return world->oracle;
+}
+
+/* 挡住 / 放开一格：能走格子图、距离场、HPA* 三份一起改 */
+static void block_cell(GameWorld *world, int x, int y) {
+    if (world->field) world->bfs_nodes += distfield_block(world->field, x, y);
+    if (world->hpa) hpa_block(world->hpa, x, y);
+    graph_block(world->graph, x, y);
+}
+
+static void unblock_cell(GameWorld *world, int x, int y) {
+    if (world->field) world->bfs_nodes += distfield_unblock(world->field, x, y);
+    if (world->hpa) hpa_unblock(world->hpa, x, y);
+    graph_unblock(world->graph, x, y);
+}
+
+/* 雷变了：重编图，顺手让后台开始重算距离表 */
+static void rebuild_graph(GameWorld *world) {
+    graph_rebuild(world->graph);
+    if (world->oracle) oracle_request(world->oracle);
+}
+
+/* 从 (x, y) 到最近的人要几步（不算身体），一个都走不到是 ORACLE_INF */
+static unsigned short oracle_nearest(const DistOracle *oracle, const GameWorld *world,
+                                     int x, int y) {
+    unsigned short best = ORACLE_INF;
+    for (int i = 0; i < world->people_count; i++) {
+        const Position *p = &world->people[i];
+        if (p->x < 0) continue;
+        unsigned short d = oracle_dist(oracle, x, y, p->x, p->y);
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+/* 和 find_safe_spawn_position 一样挑离 (10,10) 最近的格子，
+ * 但跳过走不到任何人的格子（被雷围住的死角）；一个都没有返回 false */
+static bool reachable_spawn_position(const GameWorld *world, const DistOracle *oracle,
+                                     Position *out) {
+    int best_dist = -1;
+    for (int y = 2; y < BOARD_ROWS - 2; y++) {
+        for (int x = 2; x < BOARD_COLS - 2; x++) {
+            int dist = abs(x - 10) + abs(y - 10);
+            if (best_dist >= 0 && dist >= best_dist) continue;
+            if (find_person_at(world, x, y) >= 0) continue;
+            if (oracle_nearest(oracle, world, x, y) == ORACLE_INF) continue;
+            best_dist = dist;
+            out->x = x;
+            out->y = y;
+        }
+    }
+    return best_dist >= 0;
+}
+
+void place_robot(GameWorld *world) {
+    Robot *robot = &world->robot;
+
+    if (world->rules->safe_spawn) {
+        /* 开局还没摆人，只有掉命重生时查距离表。雷变的时候后台就开始算了，
+         * 这里通常早算完；重生很少，真没算完就等一下，出生点不随时机变 */
+        DistOracle *oracle = world->oracle;
+        bool table = oracle && world->people[0].x >= 0 && oracle_wait(oracle);
+        if (!table || !reachable_spawn_position(world, oracle, &robot->pos))
+            robot->pos = find_safe_spawn_position(world->mines, world->mine_count,
+                                                  &world->obstacle);
+    } else {
+        /* 老版本：中心偏下，朝左 */
+        robot->pos.x = BOARD_COLS / 2;
+        robot->pos.y = BOARD_ROWS / 2 + 3;
+        if (robot->pos.y >= BOARD_ROWS - 1) robot->pos.y = BOARD_ROWS / 2;
+        set_direction(robot, 'W');
+    }
+}
+
+/* 无敌时头能穿墙出界，出界的那几节不记 */
+static void body_cells_add(Robot *robot, Position p, int delta) {
+    if (p.x < 0 || p.x >= BOARD_COLS || p.y < 0 || p.y >= BOARD_ROWS) return;
+    robot->body_cells[p.y * BOARD_COLS + p.x] += delta;
+}
+
+/* 根据生命数重建蛇身（身体段数 = lives；经典模式回到起始长度） */
+void reset_robot_body_from_lives(GameWorld *world) {
+    Robot *robot = &world->robot;
+
+    int len = 0;
+    if (world->rules->growth) {
+        len = GROWTH_START_SEGMENTS;
+    } else if (world->rules->body_as_lives) {
+        len = world->player.lives;
+        if (len > MAX_BODY_SEGMENTS) len = MAX_BODY_SEGMENTS;
+    }
+    if (len < 0) len = 0;
+    if (len > robot->body_cap) len = robot->body_cap;
+
+    robot->body_length = len;
+    robot->body_head   = 0;
+    memset(robot->body_cells, 0, sizeof(unsigned short) * BOARD_ROWS * BOARD_COLS);
+
+    int dx, dy;
+    direction_to_delta(robot->direction, &dx, &dy);
+    if (dx == 0 && dy == 0) { dx = -1; dy = 0; }
+
+    for (int i = 0; i < robot->body_length; i++) {
+        int bx = robot->pos.x - dx * (i + 1);
+        int by = robot->pos.y - dy * (i + 1);
+
+        if (bx <= 1 || bx >= BOARD_COLS - 2 ||
+            by <= 1 || by >= BOARD_ROWS - 2) {
+            bx = robot->pos.x;
+            by = robot->pos.y;
+        }
+
+        robot->body[i].x = bx;
+        robot->body[i].y = by;
+        body_cells_add(robot, robot->body[i], 1);
+    }
+}
+
+/* ================== 地雷 / 人 的生成 ================== */
+
+void spawn_mines(GameWorld *world, int target_count) {
+    const Robot    *robot  = &world->robot;
+    Position       *mines  = world->mines;
+
+    if (target_count > MAX_MINES) target_count = MAX_MINES;
+
+    TRACE_BEGIN("spawn_mines");
+    while (world->mine_count < target_count) {
+        int x = 1 + rand_r(&world->rng) % (BOARD_COLS - 2);
+        int y = 1 + rand_r(&world->rng) % (BOARD_ROWS - 2);
+
+        if (x == robot->pos.x && y == robot->pos.y) continue;
+        if (robot_body_at(robot, x, y)) continue;
+        if (find_person_at(world, x, y) >= 0) continue;
+        if (is_obstacle_position(&world->obstacle, x, y)) continue;
+        if (is_mine_at(mines, world->mine_count, x, y)) continue;
+
+        mines[world->mine_count].x = x;
+        mines[world->mine_count].y = y;
+        world->mine_count++;
+        block_cell(world, x, y);
+    }
+    rebuild_graph(world);
+    TRACE_END("spawn_mines");
+}
+
+int find_person_at(const GameWorld *world, int x, int y) {
+    for (int i = 0; i < world->people_count; i++) {
+        if (world->people[i].x == x && world->people[i].y == y) return i;
+    }
+    return -1;
+}
+
+static bool person_cell_free(const GameWorld *world, int x, int y) {
+    const Robot *robot = &world->robot;
+
+    if (x == robot->pos.x && y == robot->pos.y) return false;
+    if (robot_body_at(robot, x, y)) return false;
+    if (is_mine_at(world->mines, world->mine_count, x, y)) return false;
+    if (is_obstacle_position(&world->obstacle, x, y)) return false;
+    if (find_person_at(world, x, y) >= 0) return false;
+    return true;
+}
+
+/* 人换位置时顺手改距离场的源点 */
+static void set_person(GameWorld *world, int index, int x, int y) {
+    Position *person = &world->people[index];
+    DistField *field = world->field;
+    if (field) {
+        if (person->x >= 0 && x >= 0)
+            world->bfs_nodes += distfield_move_source(field, person->x, person->y, x, y);
+        else if (x >= 0)
+            world->bfs_nodes += distfield_add_source(field, x, y);
+        else if (person->x >= 0)
+            world->bfs_nodes += distfield_remove_source(field, person->x, person->y);
+    }
+    person->x = x;
+    person->y = y;
+}
+
+void spawn_person(GameWorld *world, int index) {
+
+    /* 先随机试；经典模式蛇很长时空格很少，试够一棋盘次数就按顺序找 */
+    for (int tries = 0; tries < BOARD_ROWS * BOARD_COLS; tries++) {
+        int x = 1 + rand_r(&world->rng) % (BOARD_COLS - 2);
+        int y = 1 + rand_r(&world->rng) % (BOARD_ROWS - 2);
+        if (!person_cell_free(world, x, y)) continue;
+
+        set_person(world, index, x, y);
+        return;
+    }
+
+    for (int y = 1; y < BOARD_ROWS - 1; y++) {
+        for (int x = 1; x < BOARD_COLS - 1; x++) {
+            if (!person_cell_free(world, x, y)) continue;
+            set_person(world, index, x, y);
+            return;
+        }
+    }
+
+    /* 棋盘满了：没人可救 */
+    set_person(world, index, -1, -1);
+}
+
+/* ================== 移动 ================== */
+
+/* 贪吃蛇式移动：旧的头变成第 0 节，尾巴那格被让出来（不用挪整条身体） */
+void move_robot(Robot *robot) {
+    int dx, dy;
+    direction_to_delta(robot->direction, &dx, &dy);
+
+    if (robot->body_length > 0) {
+        body_cells_add(robot, robot_tail(robot), -1);
+
+        robot->body_head = (robot->body_head + robot->body_cap - 1) % robot->body_cap;
+        robot->body[robot->body_head] = robot->pos;
+        body_cells_add(robot, robot->pos, 1);
+    }
+
+    robot->pos.x += dx;
+    robot->pos.y += dy;
+}
+
+void grow_robot(Robot *robot) {
+    if (robot->body_length >= robot->body_cap) return;
+
+    Position tail = robot_tail(robot);
+    robot->body[(robot->body_head + robot->body_length) % robot->body_cap] = tail;
+    robot->body_length++;
+    body_cells_add(robot, tail, 1);
+}
+
+/* ================== AI：BFS 寻路 ================== */
+
+/*
+ * 多源 BFS：所有人一起入队往外扩，第一次扩到机器人的头时，
+ * 是从哪一格扩过来的，那一格就是往最近的人走的下一步。
+ * 碰到头就停，不用回溯路径；要展开的格子数只看最近的人有多远，和人数无关。
+ * expanded 返回出队（展开）的节点数；avoid_body 时身体占的格子也当墙。
+ * 在能走格子图上跑，墙、障碍、雷已经不在图里；graph 要是最新的。
+ */
+static bool bfs_nearest(const Robot *robot,
+                        const Position *people, int people_count,
+                        const CellGraph *graph, bool avoid_body,
+                        char *out_dir, unsigned long *expanded) {
+    *expanded = 0;
+
+    int sx = robot->pos.x;
+    int sy = robot->pos.y;
+    if (sx < 0 || sx >= BOARD_COLS || sy < 0 || sy >= BOARD_ROWS) return false;
+
+    bool visited[BOARD_ROWS * BOARD_COLS] = {false};    // 按编号
+    int queue[BOARD_ROWS * BOARD_COLS];
+    int front = 0, back = 0;
+
+    for (int i = 0; i < people_count; i++) {
+        int tx = people[i].x;
+        int ty = people[i].y;
+        int id = graph_id(graph, tx, ty);
+        if (id < 0 || visited[id] || (tx == sx && ty == sy)) continue;
+        visited[id] = true;
+        queue[back++] = id;
+    }
+
+    const int *offset = graph->offset;
+    const int *edge   = graph->edge;
+    while (front < back) {
+        int cur = queue[front++];
+        int c   = graph->cell[cur];
+        int cx  = c % BOARD_COLS, cy = c / BOARD_COLS;
+
+        /* 头那一格可能压在障碍上（无敌时），不在图里，所以按坐标判相邻 */
+        if (abs(cx - sx) + abs(cy - sy) == 1) {
+            *expanded = (unsigned long)front;
+            if (cx > sx)      *out_dir = 'E';
+            else if (cx < sx) *out_dir = 'W';
+            else if (cy > sy) *out_dir = 'S';
+            else              *out_dir = 'N';
+            return true;
+        }
+
+        for (int e = offset[cur]; e < offset[cur + 1]; e++) {
+            int n = edge[e];
+            if (visited[n]) continue;
+            if (avoid_body && robot->body_cells[graph->cell[n]]) continue;
+            visited[n] = true;
+            queue[back++] = n;
+        }
+    }
+
+    *expanded = (unsigned long)front;
+    return false;
+}
+
+bool bfs_next_direction(const Robot *robot, const Position *person,
+                        const CellGraph *graph, char *out_dir) {
+    unsigned long expanded;
+    return bfs_nearest(robot, person, 1, graph, false, out_dir, &expanded);
+}
+
+bool bfs_nearest_direction(const Robot *robot,
+                           const Position *people, int people_count,
+                           const CellGraph *graph, char *out_dir) {
+    unsigned long expanded;
+    return bfs_nearest(robot, people, people_count, graph, false, out_dir, &expanded);
+}
+
+/* ================== AI：贪心（先 x 后 y） ================== */
+
+bool greedy_next_direction(const Robot *robot, const Position *person,
+                           const Position *mines, int mine_count,
+                           const CrossObstacle *obstacle,
+                           char *out_dir) {
+    char new_dir = robot->direction;
+
+    if (robot->pos.x < person->x)      new_dir = 'E';
+    else if (robot->pos.x > person->x) new_dir = 'W';
+    else if (robot->pos.y < person->y) new_dir = 'S';
+    else if (robot->pos.y > person->y) new_dir = 'N';
+
+    int dx, dy;
+    direction_to_delta(new_dir, &dx, &dy);
+    if (!is_blocked_cell(robot->pos.x + dx, robot->pos.y + dy,
+                         mines, mine_count, obstacle)) {
+        *out_dir = new_dir;
+        return true;
+    }
+
+    /* 简单绕行：前方挡住了，就按固定顺序找一个能走的方向 */
+    char candidates[4] = {'N','S','W','E'};
+    for (int i = 0; i < 4; i++) {
+        direction_to_delta(candidates[i], &dx, &dy);
+        if (!is_blocked_cell(robot->pos.x + dx, robot->pos.y + dy,
+                             mines, mine_count, obstacle)) {
+            *out_dir = candidates[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/* 距离场已经是最新的：往四个邻格里离人最近的那格走，邻格顺序和 BFS 一样 */
+static bool field_next_direction(const DistField *field, const Robot *robot,
+                                 char *out_dir) {
+    static const int  dirs[4][2] = {{1,0},{-1,0},{0,1},{0,-1}};
+    static const char names[4]   = {'E', 'W', 'S', 'N'};
+
+    unsigned short best = DF_INF;
+    for (int i = 0; i < 4; i++) {
+        unsigned short d = distfield_at(field, robot->pos.x + dirs[i][0],
+                                        robot->pos.y + dirs[i][1]);
+        if (d < best) {
+            best = d;
+            *out_dir = names[i];
+        }
+    }
+    return best != DF_INF;
+}
+
+/* A* 的小根堆：元素是 f << 40 | (0xFFFF - g) << 24 | 编号 */
+static void heap_push(unsigned long long *heap, int *len, unsigned long long v) {
+    int j = (*len)++;
+    while (j > 0 && heap[(j - 1) / 2] > v) {
+        heap[j] = heap[(j - 1) / 2];
+        j = (j - 1) / 2;
+    }
+    heap[j] = v;
+}
+
+static unsigned long long heap_pop(unsigned long long *heap, int *len) {
+    unsigned long long top = heap[0];
+    unsigned long long last = heap[--(*len)];
+    int i = 0;
+    for (;;) {
+        int l = 2 * i + 1;
+        if (l >= *len) break;
+        if (l + 1 < *len && heap[l + 1] < heap[l]) l++;
+        if (heap[l] >= last) break;
+        heap[i] = heap[l];
+        i = l;
+    }
+    if (*len > 0) heap[i] = last;
+    return top;
+}
+
+/* A* 的工作区，按编号，放在栈上（多局可以并行）；每次只清前 n 个 */
+typedef struct {
+    unsigned short     g[BOARD_ROWS * BOARD_COLS];
+    int                parent[BOARD_ROWS * BOARD_COLS];     // 第一步的格子是 -1
+    bool               closed[BOARD_ROWS * BOARD_COLS];
+    unsigned long long heap[4 * BOARD_ROWS * BOARD_COLS + 4]; // 每格最多展开一次、压进 4 个邻格
+    int                heap_len;
+    int                targets[MAX_PEOPLE];                 // 人所在格子的编号
+    int                n_targets;
+} AStar;
+
+/* 从 from（头是 -1）走到 n，步数 gn：比原来近就记下、入堆 */
+static void astar_relax(AStar *as, const Robot *robot, const CellGraph *graph,
+                        const DistOracle *oracle, int n, int from, int gn) {
+    if (as->closed[n] || gn >= as->g[n]) return;
+    if (robot->body_cells[graph->cell[n]]) return;
+    unsigned short h = ORACLE_INF;
+    for (int t = 0; t < as->n_targets; t++) {
+        unsigned short d = oracle_dist_id(oracle, n, as->targets[t]);
+        if (d < h) h = d;
+    }
+    if (h == ORACLE_INF) return;                // 被雷隔开，走不到任何人
+
+    as->g[n] = (unsigned short)gn;
+    as->parent[n] = from;
+    heap_push(as->heap, &as->heap_len, (unsigned long long)(gn + h) << 40 |
+                                       (unsigned long long)(0xFFFF - gn) << 24 |
+                                       (unsigned long long)n);
+}
+
+/*
+ * 经典模式的 A*：启发值查距离表，"不算身体时离最近的人还有几步"。
+ * 身体不挡路时它就是真实距离，A* 基本只沿最短路展开；身体挡住了才往旁边绕。
+ * 距离表里走不到任何人的格子直接剪掉。f 相同的先展开 g 大的（离人更近的）。
+ * 节点是能走格子图的编号。头可能压在障碍上（无敌时）、不在图里，
+ * 所以头的四个邻格按坐标找，之后都顺着邻接表走。
+ */
+static bool astar_nearest(const GameWorld *world, const CellGraph *graph,
+                          const DistOracle *oracle,
+                          char *out_dir, unsigned long *expanded) {
+    AStar as;
+    const Robot *robot = &world->robot;
+    *expanded = 0;
+
+    int sx = robot->pos.x;
+    int sy = robot->pos.y;
+    if (sx < 0 || sx >= BOARD_COLS || sy < 0 || sy >= BOARD_ROWS) return false;
+
+    as.n_targets = 0;
+    for (int i = 0; i < world->people_count; i++) {
+        int id = graph_id(graph, world->people[i].x, world->people[i].y);
+        if (id >= 0) as.targets[as.n_targets++] = id;
+    }
+    for (int v = 0; v < graph->n; v++) {
+        as.g[v] = ORACLE_INF;
+        as.closed[v] = false;
+    }
+    as.heap_len = 0;
+
+    int start = graph_id(graph, sx, sy);
+    if (start >= 0) as.closed[start] = true;    // 不往回走到头上
+
+    static const int dirs[4][2] = {{1,0},{-1,0},{0,1},{0,-1}};
+    for (int k = 0; k < 4; k++) {
+        int n = graph_id(graph, sx + dirs[k][0], sy + dirs[k][1]);
+        if (n >= 0) astar_relax(&as, robot, graph, oracle, n, -1, 1);
+    }
+
+    while (as.heap_len > 0) {
+        int cur = (int)(heap_pop(as.heap, &as.heap_len) & 0xFFFFFF);
+        if (as.closed[cur]) continue;
+        as.closed[cur] = true;
+        (*expanded)++;
+
+        for (int t = 0; t < as.n_targets; t++) {
+            if (as.targets[t] != cur) continue;
+            while (as.parent[cur] >= 0) cur = as.parent[cur];
+            int c  = graph->cell[cur];
+            int nx = c % BOARD_COLS, ny = c / BOARD_COLS;
+            if (nx > sx)      *out_dir = 'E';
+            else if (nx < sx) *out_dir = 'W';
+            else if (ny > sy) *out_dir = 'S';
+            else              *out_dir = 'N';
+            return true;
+        }
+
+        for (int e = graph->offset[cur]; e < graph->offset[cur + 1]; e++) {
+            astar_relax(&as, robot, graph, oracle, graph->edge[e], cur, as.g[cur] + 1);
+        }
+    }
+    return false;
+}
+
+void move_robot_ai(GameWorld *world) {
+    Robot *robot = &world->robot;
+    const Position *mines = world->mines;
+    int mine_count = world->mine_count;
+    const CrossObstacle *obstacle = &world->obstacle;
+
+    TRACE_BEGIN("ai");
+    char dir;
+    bool ok;
+    if (world->rules->ai == AI_GREEDY) {
+        /* 贪心：直奔曼哈顿距离最近的那个人 */
+        const Position *target = &world->people[0];
+        int best = -1;
+        for (int i = 0; i < world->people_count; i++) {
+            const Position *p = &world->people[i];
+            if (p->x < 0) continue;
+            int d = abs(p->x - robot->pos.x) + abs(p->y - robot->pos.y);
+            if (best < 0 || d < best) {
+                best = d;
+                target = p;
+            }
+        }
+        ok = greedy_next_direction(robot, target, mines, mine_count,
+                                   obstacle, &dir);
+    } else if (world->field) {
+        ok = field_next_direction(world->field, robot, &dir);
+    } else if (world->rules->growth && fresh_oracle(world)) {
+        unsigned long expanded = 0;
+        ok = astar_nearest(world, world->graph, world->oracle, &dir, &expanded);
+        world->bfs_nodes += expanded;
+    } else {
+        /* 大棋盘走 HPA*；它内存不够没算完的话，这一步退回整张 BFS */
+        bool planned = false;
+        if (world->hpa) {
+            int px[MAX_PEOPLE], py[MAX_PEOPLE];
+            for (int i = 0; i < world->people_count; i++) {
+                px[i] = world->people[i].x;
+                py[i] = world->people[i].y;
+            }
+            unsigned long before = world->hpa->expanded;
+            ok = hpa_next_direction(world->hpa, robot->pos.x, robot->pos.y,
+                                    px, py, world->people_count,
+                                    robot->body_cells, &dir);
+            world->bfs_nodes += world->hpa->expanded - before;
+            planned = !world->hpa->out_of_memory;
+        }
+        if (!planned) {
+            unsigned long expanded = 0;
+            ok = bfs_nearest(robot, world->people, world->people_count, world->graph,
+                             world->rules->growth, &dir, &expanded);
+            world->bfs_nodes += expanded;
+        }
+    }
+    if (ok) {
+        set_direction(robot, dir);
+        TRACE_END("ai");
+        return;
+    }
+
+    char candidates[4] = {'N','S','E','W'};
+    for (int k = 0; k < 4; k++) {
+        int i = rand_r(&world->rng) % 4;
+        int dx, dy;
+        direction_to_delta(candidates[i], &dx, &dy);
+        int nx = robot->pos.x + dx;
+        int ny = robot->pos.y + dy;
+        if (world->rules->growth && robot_body_at(robot, nx, ny)) continue;
+        if (!is_blocked_cell(nx, ny, mines, mine_count, obstacle)) {
+            set_direction(robot, candidates[i]);
+            break;
+        }
+    }
+    TRACE_END("ai");
+}
+
+/* ================== 碰撞检测 ================== */
+
+void check_collision(GameWorld *world, bool *running, bool *life_lost) {
+    Player *player = &world->player;
+    Robot  *robot  = &world->robot;
+
+    if (life_lost) *life_lost = false;
+
+    int x = robot->pos.x;
+    int y = robot->pos.y;
+
+    bool hit_wall = (x <= 0 || x >= BOARD_COLS - 1 ||
+                     y <= 0 || y >= BOARD_ROWS - 1);
+    bool hit_mine = is_mine_at(world->mines, world->mine_count, x, y);
+    bool hit_obs  = is_obstacle_position(&world->obstacle, x, y);
+    bool hit_self = world->rules->growth && robot_body_at(robot, x, y);
+
+    bool deadly = hit_wall || hit_mine || hit_obs || hit_self;
+
+    if (deadly && !robot->invincible) {
+        player->lives--;
+
+        if (player->lives <= 0) {
+            *running = false;
+            return;
+        }
+
+        robot->invincible       = true;
+        robot->invincible_ticks = INVINCIBLE_TICKS;
+
+        place_robot(world);
+        reset_robot_body_from_lives(world);
+
+        if (life_lost) *life_lost = true;
+    }
+
+    if (robot->invincible) {
+        robot->invincible_ticks--;
+        if (robot->invincible_ticks <= 0) {
+            robot->invincible = false;
+        }
+    }
+}
+
+/* ================== 救人 / 升级 ================== */
+
+bool handle_rescue(GameWorld *world) {
+    Player *player = &world->player;
+    Robot  *robot  = &world->robot;
+
+    int rescued = find_person_at(world, robot->pos.x, robot->pos.y);
+    if (rescued < 0) return false;
+
+    player->score += 10;
+    player->rescued++;
+    if (world->rules->growth) grow_robot(robot);
+
+    if (player->rescued >= PEOPLE_PER_LEVEL) {
+        player->level++;
+        player->rescued = 0;
+
+        spawn_mines(world, world->mine_count + MINES_PER_LEVEL);
+
+        /* 每升 5 级加一条命（一个身体段） */
+        if (world->rules->body_as_lives && player->level % 5 == 0) {
+            player->lives++;
+            if (player->lives > MAX_BODY_SEGMENTS)
+                player->lives = MAX_BODY_SEGMENTS;
+            reset_robot_body_from_lives(world);
+        }
+    }
+
+    spawn_person(world, rescued);
+    return true;
+}
+
+/* ================== 炸弹：消耗 5 等级，引爆 11×11 区域地雷 ================== */
+
+bool can_bomb(const GameWorld *world) {
+    return world->rules->bomb && world->player.level > BOMB_MIN_LEVEL;
+}
+
+/* 标记半径内的雷，并扣等级；返回是否标记到雷 */
+bool bomb_mark_mines(GameWorld *world, bool marks[MAX_MINES]) {
+    Player *player = &world->player;
+    const Position *mines = world->mines;
+    int cx = world->robot.pos.x;
+    int cy = world->robot.pos.y;
+    bool any = false;
+
+    for (int i = 0; i < world->mine_count; i++) {
+        marks[i] = abs(mines[i].x - cx) <= BOMB_RADIUS &&
+                   abs(mines[i].y - cy) <= BOMB_RADIUS;
+        if (marks[i]) any = true;
+    }
+
+    // 无论有没有命中地雷，都先扣 5 级
+    player->level -= BOMB_LEVEL_COST;
+    if (player->level < 1) player->level = 1;
+
+    return any;
+}
+
+/* 删除这些雷（压缩数组） */
+void remove_marked_mines(GameWorld *world, const bool marks[MAX_MINES]) {
+    Position *mines = world->mines;
+    int w = 0;
+    for (int i = 0; i < world->mine_count; i++) {
+        if (marks[i]) {
+            unblock_cell(world, mines[i].x, mines[i].y);
+            continue;
+        }
+        if (w != i) mines[w] = mines[i];
+        w++;
+    }
+    world->mine_count = w;
+    rebuild_graph(world);
+}
+
+/* ================== 速度控制 ================== */
+
+int get_delay_for_level(const RuleSet *rules, int level) {
+    int delay = rules->base_delay_ms;
+
+    if (rules->speed == SPEED_LINEAR) {
+        delay -= (level - 1) * rules->level_speedup_ms;
+    } else {
+        /* 对半减直到到达 level 或最小值 */
+        for (int i = 1; i < level && delay > rules->min_delay_ms; i++) {
+            delay /= 2;
+        }
+    }
+    if (delay < rules->min_delay_ms) delay = rules->min_delay_ms;
+    return delay;
+}
+
+/* ================== 每局的世界状态 ================== */
+
+GameWorld *world_create(const RuleSet *rules) {
+    GameWorld *world = calloc(1, sizeof(GameWorld));
+    if (!world) return NULL;
+
+    /* 经典模式蛇最长能铺满整张棋盘 */
+    Robot *robot = &world->robot;
+    robot->body_cap   = rules->growth ? BOARD_ROWS * BOARD_COLS : MAX_BODY_SEGMENTS;
+    robot->body       = malloc(sizeof(Position) * robot->body_cap);
+    robot->body_cells = calloc(BOARD_ROWS * BOARD_COLS, sizeof(unsigned short));
+    world->mines      = malloc(sizeof(Position) * MAX_MINES);
+    world->field      = rules->growth ? NULL : distfield_create(BOARD_COLS, BOARD_ROWS);
+    bool big          = rules->growth && BOARD_ROWS * BOARD_COLS >= HPA_MIN_CELLS;
+    world->hpa        = big ? hpa_create(BOARD_COLS, BOARD_ROWS) : NULL;
+    bool table        = (rules->growth || rules->safe_spawn) &&
+                        (BOARD_ROWS - 2) * (BOARD_COLS - 2) <= ORACLE_MAX_CELLS;
+    world->graph      = graph_create(BOARD_COLS, BOARD_ROWS);
+    world->oracle     = table && world->graph ? oracle_create(world->graph) : NULL;
+    if (!robot->body || !robot->body_cells || !world->mines || !world->graph ||
+        (!rules->growth && !world->field) || (big && !world->hpa) ||
+        (table && !world->oracle)) {
+        world_destroy(world);
+        return NULL;
+    }
+    world->rules = rules;
+    for (int i = 0; i < MAX_PEOPLE; i++) {
+        world->people[i].x = -1;
+        world->people[i].y = -1;
+    }
+    world->people_count = 1;
+    world->player.name[0] = '\0';
+    return world;
+}
+
+void world_destroy(GameWorld *world) {
+    if (!world) return;
+    free(world->robot.body);
+    free(world->robot.body_cells);
+    free(world->mines);
+    distfield_destroy(world->field);
+    hpa_destroy(world->hpa);
+    oracle_destroy(world->oracle);
+    graph_destroy(world->graph);
+    free(world);
+}
+
+void world_reset(GameWorld *world, unsigned int seed) {
+    world->rng = seed;
+    world->bfs_nodes = 0;
+
+    /* 摆墙、摆人、摆雷的时候距离场、HPA*、图都只记数，最后各自整张算一次 */
+    if (world->field) distfield_reset(world->field);
+    if (world->hpa) hpa_reset(world->hpa);
+    graph_reset(world->graph);
+
+    init_player(&world->player);
+    init_obstacle(&world->obstacle);
+    for (int y = 0; y < BOARD_ROWS; y++) {
+        for (int x = 0; x < BOARD_COLS; x++) {
+            bool wall = x == 0 || x == BOARD_COLS - 1 || y == 0 || y == BOARD_ROWS - 1;
+            if (wall || is_obstacle_position(&world->obstacle, x, y))
+                block_cell(world, x, y);
+        }
+    }
+
+    Robot *robot = &world->robot;
+    set_direction(robot, 'W');
+    robot->ai_mode          = world->rules->start_in_ai;
+    robot->invincible       = false;
+    robot->invincible_ticks = 0;
+    robot->body_length      = 0;
+    robot->body_head        = 0;
+
+    /* 上一局的人还留在数组里，先清掉，place_robot 才知道这是开局 */
+    for (int i = 0; i < MAX_PEOPLE; i++) {
+        world->people[i].x = -1;
+        world->people[i].y = -1;
+    }
+
+    world->mine_count = 0;
+    place_robot(world);
+    reset_robot_body_from_lives(world);
+
+    for (int i = 0; i < world->people_count; i++) spawn_person(world, i);
+    spawn_mines(world, BASE_MINES);
+
+    if (world->field) distfield_rebuild(world->field);
+}
+
+void world_set_people(GameWorld *world, int count) {
+    if (count < 1) count = 1;
+    if (count > MAX_PEOPLE) count = MAX_PEOPLE;
+
+    for (int i = count; i < world->people_count; i++) set_person(world, i, -1, -1);
+    int old = world->people_count;
+    world->people_count = count;
+    for (int i = old; i < count; i++) spawn_person(world, i);
+}
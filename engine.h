@@ -0,0 +1,261 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <stdbool.h>
+
+#include "distfield.h"
+#include "graph.h"
+#include "hpa.h"
+#include "oracle.h"
+
+/* ================== 规则引擎：所有版本共用的游戏逻辑 ================== */
+
+/*
+ * game.c / game_model1~6.c / game_raylib.c 以前各自复制了一份
+ * is_mine_at、spawn_mines、AI、碰撞等代码。现在这些都在 engine.c 里，
+ * 各版本之间的差别用 RuleSet 描述，前端只负责输入和绘制。
+ */
+
+/* ================== 基本宏 ================== */
+
+#ifndef BOARD_ROWS
+#define BOARD_ROWS 20
+#endif
+#ifndef BOARD_COLS
+#define BOARD_COLS 50
+#endif
+#define MAX_NAME   20
+
+#define INITIAL_LIVES      3
+#define PEOPLE_PER_LEVEL   5
+
+/* 同时在场的人最多几个（默认 1 个，world_set_people 调） */
+#define MAX_PEOPLE         16
+
+/* 经典模式棋盘格子数到这么多才改用分层寻路（HPA*），默认棋盘整张 BFS 更快 */
+#ifndef HPA_MIN_CELLS
+#define HPA_MIN_CELLS      (128 * 128)
+#endif
+
+#define MAX_MINES          50
+#define BASE_MINES         5
+#define MINES_PER_LEVEL    2
+
+#define INVINCIBLE_TICKS   10
+
+/* 贪吃蛇身体最大长度（最大生命数） */
+#define MAX_BODY_SEGMENTS  20
+
+/* 经典模式开局/复活时的身体段数 */
+#define GROWTH_START_SEGMENTS 2
+
+#define BOMB_MIN_LEVEL     10   // level > 10 才能用炸弹
+#define BOMB_LEVEL_COST    5
+#define BOMB_RADIUS        5
+
+/* ================== 规则集 ================== */
+
+typedef enum {
+    AI_GREEDY,      // 先对齐 x 再对齐 y，挡住了就随便换个方向（model1/2）
+    AI_BFS          // BFS 最短路（model3 之后）
+} AiStrategy;
+
+typedef enum {
+    SPEED_LINEAR,   // 每级减 level_speedup_ms（model1~4）
+    SPEED_HALVING   // 每级减半（model5 之后）
+} SpeedCurve;
+
+typedef struct {
+    const char *name;
+    AiStrategy  ai;
+    SpeedCurve  speed;
+    int         base_delay_ms;
+    int         level_speedup_ms;   // 只对 SPEED_LINEAR 有用
+    int         min_delay_ms;
+    bool        body_as_lives;      // 身体段数 = 生命数，每 5 级 +1 命
+    bool        safe_spawn;         // 重生在离 (10,10) 最近的安全格；否则回中心偏下
+    bool        bomb;               // 空格炸弹技能
+    bool        start_in_ai;        // 开局是否 AI 模式
+    bool        growth;             // 经典贪吃蛇：每救一个人长一节，撞到自己掉命
+} RuleSet;
+
+extern const RuleSet RULES_MODEL1;
+extern const RuleSet RULES_MODEL2;
+extern const RuleSet RULES_MODEL3;
+extern const RuleSet RULES_MODEL4;
+extern const RuleSet RULES_MODEL5;
+extern const RuleSet RULES_MODEL6;   // 也是 game.c / game_raylib.c 的规则
+extern const RuleSet RULES_CLASSIC;  // game_classic.c：经典长蛇模式
+
+/* ================== 结构体 ================== */
+
+typedef struct {
+    int x;
+    int y;
+} Position;
+
+typedef struct {
+    Position pos;           // 头部位置
+    char     direction;     // 'N','S','E','W'
+    bool     ai_mode;
+    bool     invincible;
+    int      invincible_ticks;
+
+    /* 身体是环形缓冲：body[body_head] 紧跟着头，往后依次到尾巴。
+     * 移动时只在 body_head 前面写一格，尾巴自然掉出去，和长度无关。
+     * 容量在 world_create 时按规则分配：经典模式是整张棋盘的格数 */
+    int       body_head;
+    int       body_length;  // 身体段数（不含头）
+    int       body_cap;
+    Position *body;
+
+    /* 每格压着几节身体（不含头），BOARD_ROWS*BOARD_COLS 个，跟着移动增量更新；
+     * 自撞检测只看头那一格。没有自撞时身体可以和自己重叠，所以是计数不是标记 */
+    unsigned short *body_cells;
+} Robot;
+
+/* 第 i 节身体，0 = 紧跟着头的那节 */
+static inline Position robot_segment(const Robot *robot, int i) {
+    return robot->body[(robot->body_head + i) % robot->body_cap];
+}
+
+static inline bool robot_body_at(const Robot *robot, int x, int y) {
+    if (x < 0 || x >= BOARD_COLS || y < 0 || y >= BOARD_ROWS) return false;
+    return robot->body_cells[y * BOARD_COLS + x] > 0;
+}
+
+/* 尾巴；没有身体时就是头 */
+static inline Position robot_tail(const Robot *robot) {
+    return robot->body_length > 0 ? robot_segment(robot, robot->body_length - 1)
+                                  : robot->pos;
+}
+
+typedef struct {
+    char name[MAX_NAME + 1];
+    int  score;
+    int  lives;
+    int  level;
+    int  rescued;
+    int  rank;      // 当前分数在排行榜上的实时名次，0 = 排行榜还没读完
+} Player;
+
+typedef struct {
+    int width;
+    int height;
+    int center_x;
+    int center_y;
+} CrossObstacle;
+
+/* ================== 每局的世界状态 ================== */
+
+/*
+ * 一局游戏的全部状态都在这里，引擎里没有任何全局变量，
+ * 所以一个进程里可以同时跑很多局（批量模拟、基准、服务器）。
+ * mines 在 world_create 时分配一次，world_reset 重开一局时复用。
+ */
+typedef struct {
+    const RuleSet *rules;
+
+    Player        player;
+    Robot         robot;
+    Position      people[MAX_PEOPLE];   // 没刷出来的是 (-1,-1)
+    int           people_count;         // 同时在场几个人，默认 1
+    CrossObstacle obstacle;
+
+    Position     *mines;        // 容量 MAX_MINES
+    int           mine_count;
+
+    unsigned int  rng;          // 本局自己的随机数状态（rand_r）
+
+    /* 能走的格子编成的 CSR 图：开局挡墙和障碍，加雷、炸雷后马上重编。
+     * BFS / A* / 距离表都顺着它的邻接表走，不再逐格判墙、扫雷表 */
+    CellGraph    *graph;
+
+    /* 到最近的人的距离场，加雷、炸雷、人刷新时增量修补，AI 每步只看四个邻格。
+     * 经典模式身体也算墙、每步都在变，不用它（NULL），照旧每步 BFS */
+    DistField    *field;
+
+    /* 大棋盘的经典模式：分块的入口图，加雷、炸雷时只重算碰到的块，
+     * AI 每步只在头所在的块里 BFS，再在入口图上 A*。默认棋盘是 NULL */
+    Hpa          *hpa;
+
+    /* 默认棋盘（有安全出生点或经典模式）：任意两格的距离表，图重编以后
+     * 下次要用时并行重算。经典模式的 A* 启发值、安全出生点都查它。放不下是 NULL */
+    DistOracle   *oracle;
+
+    unsigned long bfs_nodes;    // 累计 BFS 展开节点数 + 距离场修补碰到的格子数（给 profiler 看）
+} GameWorld;
+
+GameWorld *world_create(const RuleSet *rules);
+void       world_destroy(GameWorld *world);
+
+/* 新开一局：玩家、机器人、地雷、人全部重置；名字保留 */
+void world_reset(GameWorld *world, unsigned int seed);
+
+/* 同时在场的人数（截到 1..MAX_PEOPLE）：多出来的人马上撤掉，少的马上补上 */
+void world_set_people(GameWorld *world, int count);
+
+/* (x, y) 上那个人的下标，没有人返回 -1 */
+int find_person_at(const GameWorld *world, int x, int y);
+
+/* ================== 纯函数（不改状态） ================== */
+
+void set_direction(Robot *robot, char dir);
+void direction_to_delta(char dir, int *dx, int *dy);
+
+void init_player(Player *player);
+
+void init_obstacle(CrossObstacle *obstacle);
+bool is_obstacle_position(const CrossObstacle *obstacle, int x, int y);
+
+bool is_mine_at(const Position *mines, int mine_count, int x, int y);
+bool is_blocked_cell(int x, int y,
+                     const Position *mines, int mine_count,
+                     const CrossObstacle *obstacle);
+
+Position find_safe_spawn_position(const Position *mines, int mine_count,
+                                  const CrossObstacle *obstacle);
+
+void move_robot(Robot *robot);
+/* 尾巴多一节（叠在原尾巴上，下一步才分开） */
+void grow_robot(Robot *robot);
+
+/* BFS 都在能走格子图上跑（world->graph，加雷、炸雷后已经重编过） */
+bool bfs_next_direction(const Robot *robot, const Position *person,
+                        const CellGraph *graph, char *out_dir);
+/* 往最近的一个人走：从所有人同时出发做一次 BFS，碰到机器人就停，
+ * 所以耗时和人数无关；(-1,-1) 的人跳过 */
+bool bfs_nearest_direction(const Robot *robot,
+                           const Position *people, int people_count,
+                           const CellGraph *graph, char *out_dir);
+bool greedy_next_direction(const Robot *robot, const Position *person,
+                           const Position *mines, int mine_count,
+                           const CrossObstacle *obstacle,
+                           char *out_dir);
+
+int  get_delay_for_level(const RuleSet *rules, int level);
+
+/* ================== 作用在一局上的操作 ================== */
+
+/* 开局/掉命后放置机器人（按 rules->safe_spawn 选位置） */
+void place_robot(GameWorld *world);
+void reset_robot_body_from_lives(GameWorld *world);
+
+/* 补雷到 target_count 个 / 随机放第 index 个人 */
+void spawn_mines(GameWorld *world, int target_count);
+void spawn_person(GameWorld *world, int index);
+
+void move_robot_ai(GameWorld *world);
+
+/* 撞墙/雷/障碍（经典模式还有自己）：掉命并重生；lives 用完时 *running = false */
+void check_collision(GameWorld *world, bool *running, bool *life_lost);
+
+/* 头碰到人：加分、升级、加雷、加命（经典模式长一节）、在别处刷新这个人；返回是否救到 */
+bool handle_rescue(GameWorld *world);
+
+/* 炸弹：能否使用 / 标记半径内的雷并扣等级 / 删除标记的雷 */
+bool can_bomb(const GameWorld *world);
+bool bomb_mark_mines(GameWorld *world, bool marks[MAX_MINES]);
+void remove_marked_mines(GameWorld *world, const bool marks[MAX_MINES]);
+
+#endif
@@ -0,0 +1,235 @@
+#include <ncurses.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "trace.h"
+
+/*
+ * 多机器人竞技场（只看不玩）：一群 AI 机器人在同一张棋盘上抢着救人
+ * 规则见 arena.h。
+ *
+ * 编译方式：
+ *      make game_arena
+ *
+ * 运行方式：
+ *      ./game_arena [--robots N] [--people K] [--mines M] [--threads T]
+ *                   [--horizon H] [--seed S] [--trace FILE]
+ *
+ * --horizon H 打开协作规划（时空预约表，往前看 H 步），默认各自独立 BFS。
+ *
+ * 按键：+/- 调速度，r 重开，q 退出。
+ */
+
+#define PERSON       'P'
+#define MINE         'X'
+#define OBSTACLE     '#'
+
+#define CP_ROBOT     1
+#define CP_PERSON    2
+#define CP_MINE      3
+#define CP_OBSTACLE  4
+#define CP_STATUS    5
+
+#define PANEL_ROWS   10     // 侧边栏列出前几名
+
+static const int DELAYS_MS[] = { 200, 100, 50, 20, 5, 0 };
+#define DELAY_COUNT ((int)(sizeof(DELAYS_MS) / sizeof(DELAYS_MS[0])))
+
+static void init_colors(void) {
+    if (!has_colors()) return;
+    start_color();
+    use_default_colors();
+
+    init_pair(CP_ROBOT,    COLOR_WHITE,  -1);
+    init_pair(CP_PERSON,   COLOR_GREEN,  -1);
+    init_pair(CP_MINE,     COLOR_RED,    -1);
+    init_pair(CP_OBSTACLE, COLOR_YELLOW, -1);
+    init_pair(CP_STATUS,   COLOR_CYAN,   -1);
+}
+
+/* ================== 画面 ================== */
+
+static void draw_board(const Arena *arena) {
+    for (int y = 0; y < BOARD_ROWS; y++) {
+        for (int x = 0; x < BOARD_COLS; x++) {
+            bool wall = x == 0 || x == BOARD_COLS - 1 || y == 0 || y == BOARD_ROWS - 1;
+            if (wall) {
+                mvaddch(y, x, (y == 0 || y == BOARD_ROWS - 1) ? '-' : '|');
+            } else if (is_obstacle_position(&arena->obstacle, x, y)) {
+                mvaddch(y, x, OBSTACLE | COLOR_PAIR(CP_OBSTACLE));
+            } else {
+                mvaddch(y, x, ' ');
+            }
+        }
+    }
+
+    for (int i = 0; i < arena->mine_count; i++) {
+        const Position *m = &arena->mines[i];
+        if (m->x >= 0) mvaddch(m->y, m->x, MINE | COLOR_PAIR(CP_MINE));
+    }
+    for (int i = 0; i < arena->people_count; i++) {
+        const Position *p = &arena->people[i];
+        if (p->x >= 0) mvaddch(p->y, p->x, PERSON | COLOR_PAIR(CP_PERSON) | A_BOLD);
+    }
+
+    /* 身体小写、头大写，字母按编号循环 */
+    for (int i = 0; i < arena->robot_count; i++) {
+        const Robot *robot = &arena->bots[i].robot;
+        int letter = i % 26;
+        for (int s = robot->body_length - 1; s >= 0; s--) {
+            Position p = robot_segment(robot, s);
+            mvaddch(p.y, p.x, ('a' + letter) | COLOR_PAIR(CP_ROBOT));
+        }
+        mvaddch(robot->pos.y, robot->pos.x, ('A' + letter) | COLOR_PAIR(CP_ROBOT) | A_BOLD);
+    }
+}
+
+/* 分数高的在前，同分编号小的在前 */
+static bool ranks_before(const ArenaBot *bots, int x, int y) {
+    if (bots[x].score != bots[y].score) return bots[x].score > bots[y].score;
+    return x < y;
+}
+
+/* 只要前 PANEL_ROWS 名：插入式维护一个短表 */
+static int top_robots(const Arena *arena, int *top) {
+    int n = 0;
+    for (int i = 0; i < arena->robot_count; i++) {
+        int k = n < PANEL_ROWS ? n++ : PANEL_ROWS;
+        while (k > 0 && ranks_before(arena->bots, i, top[k - 1])) {
+            if (k < PANEL_ROWS) top[k] = top[k - 1];
+            k--;
+        }
+        if (k < PANEL_ROWS) top[k] = i;
+    }
+    return n;
+}
+
+static void draw_panel(const Arena *arena, int delay_idx) {
+    int col = BOARD_COLS + 2;
+    int threads = pool_threads(arena->pool);
+
+    attron(COLOR_PAIR(CP_STATUS));
+    mvprintw(0, col, "Arena  tick %-8ld", arena->tick);
+    mvprintw(1, col, "robots %d  people %d  threads %d",
+             arena->robot_count, arena->people_count, threads);
+    mvprintw(2, col, "plan %6.1f us  step %6.1f us",
+             arena->plan_ns / 1000.0, arena->step_ns / 1000.0);
+    if (arena->horizon > 0)
+        mvprintw(3, col, "coop h=%-2d  %.2f us/robot", arena->horizon,
+                 arena->plan_ns / 1000.0 / arena->robot_count);
+    else
+        mvprintw(3, col, "bfs        %.2f us/robot",
+                 arena->plan_ns / 1000.0 / arena->robot_count);
+    if (DELAYS_MS[delay_idx] > 0)
+        mvprintw(4, col, "delay %3d ms", DELAYS_MS[delay_idx]);
+    else
+        mvprintw(4, col, "delay none");
+    attroff(COLOR_PAIR(CP_STATUS));
+
+    int top[PANEL_ROWS];
+    int rows = top_robots(arena, top);
+
+    mvprintw(6, col, "    robot  score  deaths");
+    for (int r = 0; r < rows; r++) {
+        int id = top[r];
+        const ArenaBot *bot = &arena->bots[id];
+        mvprintw(7 + r, col, "%2d. %c%-4d %6d  %6d", r + 1, 'A' + id % 26, id,
+                 bot->score, bot->deaths);
+    }
+
+    mvprintw(BOARD_ROWS + 1, 0, "Keys: +/- speed   r restart   q quit");
+}
+
+/* ================== 主循环 ================== */
+
+int main(int argc, char **argv) {
+    int robots  = 8;
+    int people  = 4;
+    int mines   = 10;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int horizon = 0;
+    unsigned int seed = (unsigned int)time(NULL);
+    const char *trace_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) break;
+        if (strcmp(argv[i], "--robots") == 0)       robots  = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--people") == 0)  people  = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--mines") == 0)   mines   = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--horizon") == 0) horizon = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0)    seed    = (unsigned int)atol(argv[++i]);
+        else if (strcmp(argv[i], "--trace") == 0)   trace_path = argv[++i];
+    }
+    if (threads < 1) threads = 1;
+
+    if (trace_path) {
+        trace_start();
+        trace_thread_name("main");
+    }
+
+    Arena *arena = arena_create(robots, people, mines, threads);
+    if (!arena || !arena_set_horizon(arena, horizon)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bool room = arena_reset(arena, seed);
+    if (!room) {
+        fprintf(stderr, "the board has no room for %d robots\n", arena->robot_count);
+        arena_destroy(arena);
+        return 1;
+    }
+
+    initscr();
+    cbreak();
+    noecho();
+    curs_set(0);
+    keypad(stdscr, TRUE);
+    init_colors();
+
+    int delay_idx = 2;
+    bool running = true;
+    while (running) {
+        TRACE_BEGIN("arena_frame");
+        arena_tick(arena);
+        erase();
+        draw_board(arena);
+        draw_panel(arena, delay_idx);
+        refresh();
+        TRACE_END("arena_frame");
+
+        /* 按键也用 getch 的超时来等下一帧 */
+        timeout(DELAYS_MS[delay_idx]);
+        int ch = getch();
+        switch (ch) {
+            case 'q': case 'Q':
+                running = false;
+                break;
+            case '+': case '=':
+                if (delay_idx < DELAY_COUNT - 1) delay_idx++;
+                break;
+            case '-': case '_':
+                if (delay_idx > 0) delay_idx--;
+                break;
+            case 'r': case 'R':
+                room = arena_reset(arena, ++seed);
+                if (!room) running = false;
+                break;
+            default:
+                break;
+        }
+    }
+
+    endwin();
+    if (!room) fprintf(stderr, "the board has no room for %d robots\n", arena->robot_count);
+    arena_destroy(arena);
+
+    if (trace_path && !trace_write(trace_path)) {
+        fprintf(stderr, "could not write %s\n", trace_path);
+    }
+    return 0;
+}
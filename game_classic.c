@@ -0,0 +1,13 @@
+#include "curses_frontend.h"
+
+/*
+ * 经典模式：每救一个人蛇身长一节，撞到自己也会掉命。
+ * 游戏规则在 engine.c 的 RULES_CLASSIC 里，界面在 curses_frontend.c。
+ *
+ * 编译方式：
+ *      make game_classic
+ */
+
+int main(int argc, char **argv) {
+    return run_curses_game(&RULES_CLASSIC, argc, argv);
+}
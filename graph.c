@@ -0,0 +1,92 @@
+#include "graph.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ================== 创建 / 销毁 ================== */
+
+CellGraph *graph_create(int w, int h) {
+    CellGraph *graph = calloc(1, sizeof(CellGraph));
+    if (!graph) return NULL;
+
+    graph->w = w;
+    graph->h = h;
+    size_t cells = (size_t)w * h;
+    graph->blocked = calloc(cells, 1);
+    graph->id      = malloc(cells * sizeof(int));
+    graph->cell    = malloc(cells * sizeof(int));
+    graph->offset  = malloc((cells + 1) * sizeof(int));
+    graph->edge    = malloc(cells * 4 * sizeof(int));
+    if (!graph->blocked || !graph->id || !graph->cell ||
+        !graph->offset || !graph->edge) {
+        graph_destroy(graph);
+        return NULL;
+    }
+    graph_reset(graph);
+    graph_rebuild(graph);
+    return graph;
+}
+
+void graph_destroy(CellGraph *graph) {
+    if (!graph) return;
+    free(graph->blocked);
+    free(graph->id);
+    free(graph->cell);
+    free(graph->offset);
+    free(graph->edge);
+    free(graph);
+}
+
+/* ================== 挡住 / 放开 ================== */
+
+void graph_reset(CellGraph *graph) {
+    memset(graph->blocked, 0, (size_t)graph->w * graph->h);
+    graph->dirty = true;
+}
+
+void graph_block(CellGraph *graph, int x, int y) {
+    if (graph->blocked[y * graph->w + x]++ == 0) graph->dirty = true;
+}
+
+void graph_unblock(CellGraph *graph, int x, int y) {
+    int c = y * graph->w + x;
+    if (graph->blocked[c] == 0) return;
+    if (--graph->blocked[c] == 0) graph->dirty = true;
+}
+
+/* ================== 重编 ================== */
+
+void graph_rebuild(CellGraph *graph) {
+    if (!graph->dirty) return;
+
+    int w = graph->w, h = graph->h;
+    int n = 0;
+    for (int c = 0; c < w * h; c++) {
+        graph->id[c] = -1;
+        if (graph->blocked[c]) continue;
+        graph->id[c] = n;
+        graph->cell[n++] = c;
+    }
+
+    /* 东、西、南、北 */
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        int c = graph->cell[i];
+        int x = c % w, y = c / w;
+        int nb[4] = {
+            x + 1 < w ? graph->id[c + 1] : -1,
+            x > 0     ? graph->id[c - 1] : -1,
+            y + 1 < h ? graph->id[c + w] : -1,
+            y > 0     ? graph->id[c - w] : -1,
+        };
+        graph->offset[i] = m;
+        for (int k = 0; k < 4; k++) {
+            if (nb[k] >= 0) graph->edge[m++] = nb[k];
+        }
+    }
+    graph->offset[n] = m;
+
+    graph->n = n;
+    graph->dirty = false;
+    graph->version++;
+}
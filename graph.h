@@ -0,0 +1,50 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stdbool.h>
+
+/* ================== 能走的格子编成的图（CSR） ================== */
+
+/*
+ * 墙、障碍、雷以外的格子按行优先编成连续的号 0..n-1，
+ * 邻接表压成两个数组：编号 i 的邻居是 edge[offset[i] .. offset[i+1])，
+ * 顺序固定是 东、西、南、北（和 BFS 的邻格顺序一样，结果逐步对得上）。
+ * 搜索时只顺着 edge 往下读，不用再判出界、查障碍、扫雷表。
+ *
+ * blocked 是计数（墙开局挡一次，雷挡 / 放开），变了只记一笔，
+ * graph_rebuild 时整张重编（O(格子数)，默认棋盘几微秒），没变什么都不做。
+ * 编号整张重排，所以 version 每次重编加一，拿编号建缓存的（oracle.h）靠它判断过期。
+ */
+
+typedef struct {
+    int w, h;
+
+    unsigned char *blocked;     // [w*h] 计数
+    int           *id;          // [w*h] 格子的编号，挡住的是 -1
+    int           *cell;        // [n] 编号对应的格子 y*w+x
+    int           *offset;      // [n+1]
+    int           *edge;        // [offset[n]]，最多 4n
+    int            n;
+
+    bool           dirty;       // blocked 变过，还没重编
+    unsigned int   version;
+} CellGraph;
+
+CellGraph *graph_create(int w, int h);
+void       graph_destroy(CellGraph *graph);
+
+/* 全部放开 */
+void graph_reset(CellGraph *graph);
+void graph_block(CellGraph *graph, int x, int y);
+void graph_unblock(CellGraph *graph, int x, int y);
+
+/* 变过才重编 */
+void graph_rebuild(CellGraph *graph);
+
+/* (x, y) 的编号；出界或挡住是 -1。只在重编之后用 */
+static inline int graph_id(const CellGraph *graph, int x, int y) {
+    if (x < 0 || x >= graph->w || y < 0 || y >= graph->h) return -1;
+    return graph->id[y * graph->w + x];
+}
+
+#endif
@@ -0,0 +1,530 @@
+#include "hpa.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define HPA_INF 0xFFFF
+
+/*
+ * 编号约定：
+ *   竖边界 b = cy * (ncx-1) + cx：块 (cx,cy) 和 (cx+1,cy) 之间；
+ *   横边界 b = n_vborders + cy * ncx + cx：块 (cx,cy) 和 (cx,cy+1) 之间。
+ *   节点 = (b * HPA_MAX_ENT + e) * 2 + side，side 0 在编号小的那块（左 / 上）。
+ *   块里的槽位 slot = dir * HPA_MAX_ENT + e，dir：0 左边、1 右边、2 上边、3 下边。
+ */
+
+static int cluster_of(const Hpa *hpa, int x, int y) {
+    return (y / HPA_CLUSTER) * hpa->ncx + x / HPA_CLUSTER;
+}
+
+/* 块 (cx,cy) 第 dir 条边是哪条边界，本块在哪一侧；棋盘边上没有返回 -1 */
+static int cluster_border(const Hpa *hpa, int cx, int cy, int dir, int *side) {
+    switch (dir) {
+        case 0:  *side = 1; return cx > 0 ? cy * (hpa->ncx - 1) + cx - 1 : -1;
+        case 1:  *side = 0; return cx + 1 < hpa->ncx ? cy * (hpa->ncx - 1) + cx : -1;
+        case 2:  *side = 1; return cy > 0 ? hpa->n_vborders + (cy - 1) * hpa->ncx + cx : -1;
+        default: *side = 0; return cy + 1 < hpa->ncy ? hpa->n_vborders + cy * hpa->ncx + cx : -1;
+    }
+}
+
+/* 节点所在的格子 */
+static int node_cell(const Hpa *hpa, int node) {
+    int side = node & 1;
+    int be   = node >> 1;
+    int b    = be / HPA_MAX_ENT;
+    int c    = hpa->ent_cell[be];
+    if (!side) return c;
+    return b < hpa->n_vborders ? c + 1 : c + hpa->w;
+}
+
+/* 节点在哪一块、哪个槽位 */
+static int node_cluster(const Hpa *hpa, int node, int *slot) {
+    int side = node & 1;
+    int be   = node >> 1;
+    int b    = be / HPA_MAX_ENT;
+    int e    = be % HPA_MAX_ENT;
+    if (b < hpa->n_vborders) {
+        int cy = b / (hpa->ncx - 1), cx = b % (hpa->ncx - 1);
+        *slot = (side ? 0 : 1) * HPA_MAX_ENT + e;
+        return cy * hpa->ncx + cx + side;
+    }
+    b -= hpa->n_vborders;
+    int cy = b / hpa->ncx, cx = b % hpa->ncx;
+    *slot = (side ? 2 : 3) * HPA_MAX_ENT + e;
+    return (cy + side) * hpa->ncx + cx;
+}
+
+/* ================== 创建 / 销毁 ================== */
+
+Hpa *hpa_create(int w, int h) {
+    Hpa *hpa = calloc(1, sizeof(Hpa));
+    if (!hpa) return NULL;
+
+    hpa->w   = w;
+    hpa->h   = h;
+    hpa->ncx = (w + HPA_CLUSTER - 1) / HPA_CLUSTER;
+    hpa->ncy = (h + HPA_CLUSTER - 1) / HPA_CLUSTER;
+    hpa->n_vborders = (hpa->ncx - 1) * hpa->ncy;
+    hpa->n_borders  = hpa->n_vborders + hpa->ncx * (hpa->ncy - 1);
+    hpa->n_nodes    = hpa->n_borders * HPA_MAX_ENT * 2;
+
+    size_t cells    = (size_t)w * h;
+    size_t clusters = (size_t)hpa->ncx * hpa->ncy;
+    size_t borders  = (size_t)(hpa->n_borders > 0 ? hpa->n_borders : 1);
+    size_t nodes    = (size_t)(hpa->n_nodes > 0 ? hpa->n_nodes : 1);
+    size_t local    = HPA_CLUSTER * HPA_CLUSTER;
+
+    hpa->blocked        = calloc(cells, 1);
+    hpa->ent_count      = calloc(borders, 1);
+    hpa->ent_cell       = calloc(borders * HPA_MAX_ENT, sizeof(int));
+    hpa->cl_dist        = malloc(clusters * HPA_SLOTS * HPA_SLOTS * sizeof(unsigned short));
+    hpa->border_dirty   = calloc(borders, 1);
+    hpa->cluster_dirty  = calloc(clusters, 1);
+    hpa->dirty_borders  = malloc(borders * sizeof(int));
+    hpa->dirty_clusters = malloc(clusters * sizeof(int));
+    hpa->g              = malloc(nodes * sizeof(unsigned int));
+    hpa->parent         = malloc(nodes * sizeof(int));
+    hpa->seen           = calloc(nodes, sizeof(unsigned int));
+    hpa->goal_cost      = malloc(nodes * sizeof(unsigned short));
+    hpa->goal_seen      = calloc(nodes, sizeof(unsigned int));
+    hpa->heap_cap       = 1024;
+    hpa->heap           = malloc((size_t)hpa->heap_cap * sizeof(unsigned long long));
+    hpa->local_dist     = malloc(local * sizeof(unsigned short));
+    hpa->local_prev     = malloc(local * sizeof(int));
+    hpa->start_dist     = malloc(local * sizeof(unsigned short));
+    hpa->start_prev     = malloc(local * sizeof(int));
+    hpa->local_queue    = malloc(local * sizeof(int));
+    if (!hpa->blocked || !hpa->ent_count || !hpa->ent_cell || !hpa->cl_dist ||
+        !hpa->border_dirty || !hpa->cluster_dirty || !hpa->dirty_borders ||
+        !hpa->dirty_clusters || !hpa->g || !hpa->parent || !hpa->seen ||
+        !hpa->goal_cost || !hpa->goal_seen || !hpa->heap ||
+        !hpa->local_dist || !hpa->local_prev || !hpa->start_dist ||
+        !hpa->start_prev || !hpa->local_queue) {
+        hpa_destroy(hpa);
+        return NULL;
+    }
+    hpa_reset(hpa);
+    return hpa;
+}
+
+void hpa_destroy(Hpa *hpa) {
+    if (!hpa) return;
+    free(hpa->blocked);
+    free(hpa->ent_count);
+    free(hpa->ent_cell);
+    free(hpa->cl_dist);
+    free(hpa->border_dirty);
+    free(hpa->cluster_dirty);
+    free(hpa->dirty_borders);
+    free(hpa->dirty_clusters);
+    free(hpa->g);
+    free(hpa->parent);
+    free(hpa->seen);
+    free(hpa->goal_cost);
+    free(hpa->goal_seen);
+    free(hpa->heap);
+    free(hpa->local_dist);
+    free(hpa->local_prev);
+    free(hpa->start_dist);
+    free(hpa->start_prev);
+    free(hpa->local_queue);
+    free(hpa);
+}
+
+/* ================== 标脏 ================== */
+
+static void mark_border(Hpa *hpa, int b) {
+    if (b < 0 || hpa->border_dirty[b]) return;
+    hpa->border_dirty[b] = 1;
+    hpa->dirty_borders[hpa->n_dirty_borders++] = b;
+}
+
+static void mark_cluster(Hpa *hpa, int c) {
+    if (hpa->cluster_dirty[c]) return;
+    hpa->cluster_dirty[c] = 1;
+    hpa->dirty_clusters[hpa->n_dirty_clusters++] = c;
+}
+
+void hpa_reset(Hpa *hpa) {
+    memset(hpa->blocked, 0, (size_t)hpa->w * hpa->h);
+    hpa->n_dirty_borders  = 0;
+    hpa->n_dirty_clusters = 0;
+    memset(hpa->border_dirty, 0, (size_t)(hpa->n_borders > 0 ? hpa->n_borders : 1));
+    memset(hpa->cluster_dirty, 0, (size_t)hpa->ncx * hpa->ncy);
+    for (int b = 0; b < hpa->n_borders; b++) mark_border(hpa, b);
+    for (int c = 0; c < hpa->ncx * hpa->ncy; c++) mark_cluster(hpa, c);
+}
+
+/* 格子变了：本块要重算块内距离；在块的边上的话，那条边界和隔壁块也要重算 */
+static void cell_changed(Hpa *hpa, int x, int y) {
+    int cx = x / HPA_CLUSTER, cy = y / HPA_CLUSTER;
+    int lx = x % HPA_CLUSTER, ly = y % HPA_CLUSTER;
+    mark_cluster(hpa, cy * hpa->ncx + cx);
+
+    int side;
+    int edge[4] = { lx == 0, lx == HPA_CLUSTER - 1, ly == 0, ly == HPA_CLUSTER - 1 };
+    int dx[4] = { -1, 1, 0, 0 }, dy[4] = { 0, 0, -1, 1 };
+    for (int dir = 0; dir < 4; dir++) {
+        if (!edge[dir]) continue;
+        int b = cluster_border(hpa, cx, cy, dir, &side);
+        if (b < 0) continue;
+        mark_border(hpa, b);
+        mark_cluster(hpa, (cy + dy[dir]) * hpa->ncx + cx + dx[dir]);
+    }
+}
+
+void hpa_block(Hpa *hpa, int x, int y) {
+    if (hpa->blocked[y * hpa->w + x]++ == 0) cell_changed(hpa, x, y);
+}
+
+void hpa_unblock(Hpa *hpa, int x, int y) {
+    int c = y * hpa->w + x;
+    if (hpa->blocked[c] == 0) return;
+    if (--hpa->blocked[c] == 0) cell_changed(hpa, x, y);
+}
+
+/* ================== 重算入口和块内距离 ================== */
+
+/* 边界上连续的通路段，每段取中间一对当入口 */
+static void build_border(Hpa *hpa, int b) {
+    int x0, y0, step, len, across;
+    if (b < hpa->n_vborders) {
+        int cy = b / (hpa->ncx - 1), cx = b % (hpa->ncx - 1);
+        x0 = cx * HPA_CLUSTER + HPA_CLUSTER - 1;
+        y0 = cy * HPA_CLUSTER;
+        step = hpa->w;
+        across = 1;
+        len = hpa->h - y0 < HPA_CLUSTER ? hpa->h - y0 : HPA_CLUSTER;
+    } else {
+        int hb = b - hpa->n_vborders;
+        int cy = hb / hpa->ncx, cx = hb % hpa->ncx;
+        x0 = cx * HPA_CLUSTER;
+        y0 = cy * HPA_CLUSTER + HPA_CLUSTER - 1;
+        step = 1;
+        across = hpa->w;
+        len = hpa->w - x0 < HPA_CLUSTER ? hpa->w - x0 : HPA_CLUSTER;
+    }
+
+    int base = y0 * hpa->w + x0;
+    int count = 0;
+    int run = -1;
+    for (int i = 0; i <= len; i++) {
+        int c = base + i * step;
+        bool open = i < len && !hpa->blocked[c] && !hpa->blocked[c + across];
+        if (open && run < 0) run = i;
+        if (!open && run >= 0) {
+            if (count < HPA_MAX_ENT)
+                hpa->ent_cell[b * HPA_MAX_ENT + count++] = base + ((run + i - 1) / 2) * step;
+            run = -1;
+        }
+    }
+    hpa->ent_count[b] = (unsigned char)count;
+}
+
+/* 块 (cx,cy) 里从 start 出发的 BFS，只在块内走；avoid 的格子也当墙 */
+static void local_bfs(Hpa *hpa, int cx, int cy, int start, const unsigned short *avoid,
+                      unsigned short *dist, int *prev) {
+    int x0 = cx * HPA_CLUSTER, y0 = cy * HPA_CLUSTER;
+    int cw = hpa->w - x0 < HPA_CLUSTER ? hpa->w - x0 : HPA_CLUSTER;
+    int ch = hpa->h - y0 < HPA_CLUSTER ? hpa->h - y0 : HPA_CLUSTER;
+
+    for (int i = 0; i < HPA_CLUSTER * HPA_CLUSTER; i++) dist[i] = HPA_INF;
+
+    int *queue = hpa->local_queue;
+    int front = 0, back = 0;
+    int sl = (start / hpa->w - y0) * HPA_CLUSTER + start % hpa->w - x0;
+    dist[sl] = 0;
+    prev[sl] = -1;
+    queue[back++] = sl;
+
+    int dx[4] = { 1, -1, 0, 0 }, dy[4] = { 0, 0, 1, -1 };
+    while (front < back) {
+        int l = queue[front++];
+        int lx = l % HPA_CLUSTER, ly = l / HPA_CLUSTER;
+        for (int k = 0; k < 4; k++) {
+            int nx = lx + dx[k], ny = ly + dy[k];
+            if (nx < 0 || nx >= cw || ny < 0 || ny >= ch) continue;
+            int nl = ny * HPA_CLUSTER + nx;
+            if (dist[nl] != HPA_INF) continue;
+            int c = (y0 + ny) * hpa->w + x0 + nx;
+            if (hpa->blocked[c] || (avoid && avoid[c])) continue;
+            dist[nl] = dist[l] + 1;
+            prev[nl] = l;
+            queue[back++] = nl;
+        }
+    }
+    hpa->expanded += (unsigned long)front;
+}
+
+static int local_index(const Hpa *hpa, int cx, int cy, int cell) {
+    return (cell / hpa->w - cy * HPA_CLUSTER) * HPA_CLUSTER + cell % hpa->w - cx * HPA_CLUSTER;
+}
+
+/* 块内各入口两两之间的距离 */
+static void build_cluster(Hpa *hpa, int c) {
+    int cx = c % hpa->ncx, cy = c / hpa->ncx;
+    unsigned short *d = hpa->cl_dist + (size_t)c * HPA_SLOTS * HPA_SLOTS;
+    for (int i = 0; i < HPA_SLOTS * HPA_SLOTS; i++) d[i] = HPA_INF;
+
+    int slot_cell[HPA_SLOTS];
+    for (int s = 0; s < HPA_SLOTS; s++) {
+        int side;
+        int b = cluster_border(hpa, cx, cy, s / HPA_MAX_ENT, &side);
+        int e = s % HPA_MAX_ENT;
+        slot_cell[s] = -1;
+        if (b < 0 || e >= hpa->ent_count[b]) continue;
+        slot_cell[s] = node_cell(hpa, (b * HPA_MAX_ENT + e) * 2 + side);
+    }
+
+    for (int s = 0; s < HPA_SLOTS; s++) {
+        if (slot_cell[s] < 0) continue;
+        local_bfs(hpa, cx, cy, slot_cell[s], NULL, hpa->local_dist, hpa->local_prev);
+        for (int t = 0; t < HPA_SLOTS; t++) {
+            if (slot_cell[t] < 0) continue;
+            d[s * HPA_SLOTS + t] = hpa->local_dist[local_index(hpa, cx, cy, slot_cell[t])];
+        }
+    }
+}
+
+static void flush_dirty(Hpa *hpa) {
+    for (int i = 0; i < hpa->n_dirty_borders; i++) {
+        int b = hpa->dirty_borders[i];
+        build_border(hpa, b);
+        hpa->border_dirty[b] = 0;
+    }
+    hpa->n_dirty_borders = 0;
+
+    for (int i = 0; i < hpa->n_dirty_clusters; i++) {
+        int c = hpa->dirty_clusters[i];
+        build_cluster(hpa, c);
+        hpa->cluster_dirty[c] = 0;
+    }
+    hpa->n_dirty_clusters = 0;
+}
+
+/* ================== 查询：抽象图上的 A* ================== */
+
+#define GOAL_NODE (-2)      // 虚拟终点，不占节点编号
+
+static bool heap_push(Hpa *hpa, unsigned int f, int node) {
+    if (hpa->heap_len == hpa->heap_cap) {
+        int cap = hpa->heap_cap * 2;
+        unsigned long long *tmp = realloc(hpa->heap, (size_t)cap * sizeof(unsigned long long));
+        if (!tmp) return false;
+        hpa->heap = tmp;
+        hpa->heap_cap = cap;
+    }
+    /* 虚拟终点存成 n_nodes */
+    unsigned long long v = (unsigned long long)f << 32 |
+                           (unsigned int)(node == GOAL_NODE ? hpa->n_nodes : node);
+    int i = hpa->heap_len++;
+    while (i > 0 && hpa->heap[(i - 1) / 2] > v) {
+        hpa->heap[i] = hpa->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    hpa->heap[i] = v;
+    return true;
+}
+
+/* 堆扩不动了：这次查询作废，调用方看 out_of_memory 换别的寻路 */
+static bool out_of_memory(Hpa *hpa) {
+    hpa->out_of_memory = true;
+    hpa->heap_len = 0;
+    return false;
+}
+
+static unsigned long long heap_pop(Hpa *hpa) {
+    unsigned long long top = hpa->heap[0];
+    unsigned long long last = hpa->heap[--hpa->heap_len];
+    int i = 0;
+    for (;;) {
+        int l = 2 * i + 1;
+        if (l >= hpa->heap_len) break;
+        if (l + 1 < hpa->heap_len && hpa->heap[l + 1] < hpa->heap[l]) l++;
+        if (hpa->heap[l] >= last) break;
+        hpa->heap[i] = hpa->heap[l];
+        i = l;
+    }
+    if (hpa->heap_len > 0) hpa->heap[i] = last;
+    return top;
+}
+
+/* 启发：到最近的人的曼哈顿距离 */
+static unsigned int heuristic(const Hpa *hpa, int cell,
+                              const int *px, const int *py, int n) {
+    int x = cell % hpa->w, y = cell / hpa->w;
+    unsigned int best = HPA_INF;
+    for (int i = 0; i < n; i++) {
+        if (px[i] < 0) continue;
+        unsigned int d = (unsigned int)(abs(px[i] - x) + abs(py[i] - y));
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+static char direction_to(const Hpa *hpa, int from, int to) {
+    if (to == from + 1)      return 'E';
+    if (to == from - 1)      return 'W';
+    if (to == from + hpa->w) return 'S';
+    return 'N';
+}
+
+bool hpa_next_direction(Hpa *hpa, int sx, int sy,
+                        const int *people_x, const int *people_y, int people_count,
+                        const unsigned short *avoid, char *out_dir) {
+    hpa->out_of_memory = false;
+    if (sx < 0 || sx >= hpa->w || sy < 0 || sy >= hpa->h) return false;
+    flush_dirty(hpa);
+
+    int start = sy * hpa->w + sx;
+    int scx = sx / HPA_CLUSTER, scy = sy / HPA_CLUSTER;
+    int sc  = scy * hpa->ncx + scx;
+
+    /* 1. 机器人所在块里的 BFS：能直接走到的人，和能走到的入口 */
+    local_bfs(hpa, scx, scy, start, avoid, hpa->start_dist, hpa->start_prev);
+
+    unsigned int best = HPA_INF;    // 目前找到的最短总步数
+    int best_target = -1;           // 对应要先走到的本块格子
+    for (int i = 0; i < people_count; i++) {
+        if (people_x[i] < 0) continue;
+        if (cluster_of(hpa, people_x[i], people_y[i]) != sc) continue;
+        int cell = people_y[i] * hpa->w + people_x[i];
+        unsigned short d = hpa->start_dist[local_index(hpa, scx, scy, cell)];
+        if (d < best) {
+            best = d;
+            best_target = cell;
+        }
+    }
+
+    if (++hpa->stamp == 0) {
+        memset(hpa->seen, 0, sizeof(unsigned int) * (size_t)hpa->n_nodes);
+        memset(hpa->goal_seen, 0, sizeof(unsigned int) * (size_t)hpa->n_nodes);
+        hpa->stamp = 1;
+    }
+    unsigned int stamp = hpa->stamp;
+    hpa->heap_len = 0;
+
+    /* 2. 每个人在自己块里挂到入口上（别的块不避身体） */
+    for (int i = 0; i < people_count; i++) {
+        if (people_x[i] < 0) continue;
+        int pcx = people_x[i] / HPA_CLUSTER, pcy = people_y[i] / HPA_CLUSTER;
+        int cell = people_y[i] * hpa->w + people_x[i];
+        local_bfs(hpa, pcx, pcy, cell, pcy == scy && pcx == scx ? avoid : NULL,
+                  hpa->local_dist, hpa->local_prev);
+        for (int s = 0; s < HPA_SLOTS; s++) {
+            int side;
+            int b = cluster_border(hpa, pcx, pcy, s / HPA_MAX_ENT, &side);
+            int e = s % HPA_MAX_ENT;
+            if (b < 0 || e >= hpa->ent_count[b]) continue;
+            int node = (b * HPA_MAX_ENT + e) * 2 + side;
+            unsigned short d = hpa->local_dist[local_index(hpa, pcx, pcy, node_cell(hpa, node))];
+            if (d == HPA_INF) continue;
+            if (hpa->goal_seen[node] != stamp || d < hpa->goal_cost[node]) {
+                hpa->goal_seen[node] = stamp;
+                hpa->goal_cost[node] = d;
+            }
+        }
+    }
+
+    /* 3. 起点块里走得到的入口入堆 */
+    for (int s = 0; s < HPA_SLOTS; s++) {
+        int side;
+        int b = cluster_border(hpa, scx, scy, s / HPA_MAX_ENT, &side);
+        int e = s % HPA_MAX_ENT;
+        if (b < 0 || e >= hpa->ent_count[b]) continue;
+        int node = (b * HPA_MAX_ENT + e) * 2 + side;
+        int cell = node_cell(hpa, node);
+        unsigned short d = hpa->start_dist[local_index(hpa, scx, scy, cell)];
+        if (d == HPA_INF) continue;
+        hpa->seen[node]   = stamp;
+        hpa->g[node]      = d;
+        hpa->parent[node] = -1;
+        if (!heap_push(hpa, d + heuristic(hpa, cell, people_x, people_y, people_count), node))
+            return out_of_memory(hpa);
+    }
+
+    /* 4. A*；虚拟终点的 g 记在 goal_g */
+    unsigned int goal_g = HPA_INF;
+    int goal_parent = -1;
+    while (hpa->heap_len > 0) {
+        unsigned long long top = heap_pop(hpa);
+        unsigned int f = (unsigned int)(top >> 32);
+        int u = (int)(top & 0xffffffffu);
+        if (f >= best) break;                       // 块内直达已经不比这更差
+        if (u == hpa->n_nodes) {
+            best = goal_g;
+            best_target = -1;
+            break;
+        }
+        unsigned int gu = hpa->g[u];
+        if (f > gu + heuristic(hpa, node_cell(hpa, u), people_x, people_y, people_count))
+            continue;                               // 过期的堆元素
+        hpa->expanded++;
+
+        if (hpa->goal_seen[u] == stamp && gu + hpa->goal_cost[u] < goal_g) {
+            goal_g = gu + hpa->goal_cost[u];
+            goal_parent = u;
+            if (!heap_push(hpa, goal_g, GOAL_NODE)) return out_of_memory(hpa);
+        }
+
+        /* 跨边界到对面 */
+        int v = u ^ 1;
+        if (hpa->seen[v] != stamp || gu + 1 < hpa->g[v]) {
+            hpa->seen[v]   = stamp;
+            hpa->g[v]      = gu + 1;
+            hpa->parent[v] = u;
+            if (!heap_push(hpa, gu + 1 + heuristic(hpa, node_cell(hpa, v), people_x, people_y,
+                                                   people_count), v))
+                return out_of_memory(hpa);
+        }
+
+        /* 块内到同块其他入口。起点块的入口已经按避开身体的距离全放进去了，
+         * 不再从那几个种子走不避身体的块内边 */
+        int slot;
+        int c = node_cluster(hpa, u, &slot);
+        if (c == sc && hpa->parent[u] < 0) continue;
+        const unsigned short *row = hpa->cl_dist + ((size_t)c * HPA_SLOTS + slot) * HPA_SLOTS;
+        int cx = c % hpa->ncx, cy = c / hpa->ncx;
+        for (int t = 0; t < HPA_SLOTS; t++) {
+            if (t == slot || row[t] == HPA_INF) continue;
+            int side;
+            int b = cluster_border(hpa, cx, cy, t / HPA_MAX_ENT, &side);
+            int w = (b * HPA_MAX_ENT + t % HPA_MAX_ENT) * 2 + side;
+            unsigned int gw = gu + row[t];
+            if (hpa->seen[w] == stamp && gw >= hpa->g[w]) continue;
+            hpa->seen[w]   = stamp;
+            hpa->g[w]      = gw;
+            hpa->parent[w] = u;
+            if (!heap_push(hpa, gw + heuristic(hpa, node_cell(hpa, w), people_x, people_y,
+                                               people_count), w))
+                return out_of_memory(hpa);
+        }
+    }
+
+    if (best == HPA_INF) return false;
+
+    /* 5. 只细化第一段：沿抽象路径找第一个不在机器人脚下的入口 */
+    int target = best_target;
+    if (target < 0) {
+        int first = -1;
+        for (int n = goal_parent; n >= 0; n = hpa->parent[n]) {
+            if (node_cell(hpa, n) != start) first = n;
+        }
+        if (first < 0) return false;
+        target = node_cell(hpa, first);
+    }
+
+    if (cluster_of(hpa, target % hpa->w, target / hpa->w) != sc) {
+        /* 机器人就站在入口上，下一步直接跨过边界 */
+        *out_dir = direction_to(hpa, start, target);
+        return true;
+    }
+
+    int l  = local_index(hpa, scx, scy, target);
+    int sl = local_index(hpa, scx, scy, start);
+    if (l == sl || hpa->start_dist[l] == HPA_INF) return false;
+    while (hpa->start_prev[l] != sl) l = hpa->start_prev[l];
+    int x0 = scx * HPA_CLUSTER, y0 = scy * HPA_CLUSTER;
+    *out_dir = direction_to(hpa, start, (y0 + l / HPA_CLUSTER) * hpa->w + x0 + l % HPA_CLUSTER);
+    return true;
+}
@@ -0,0 +1,88 @@
+#ifndef HPA_H
+#define HPA_H
+
+#include <stdbool.h>
+
+/* ================== 大棋盘的分层寻路（HPA*） ================== */
+
+/*
+ * 棋盘切成 HPA_CLUSTER × HPA_CLUSTER 的块。相邻两块之间的边界上，
+ * 每一段连续的"两边都能走"的格子取中间一对当入口，入口两侧各是一个抽象节点：
+ *   - 跨边界：一对入口之间代价 1；
+ *   - 块内：同一块里任意两个入口之间的最短步数，在块内 BFS 预先算好。
+ *
+ * 查询时只在机器人所在的块里做一次块内 BFS（可以避开自己的身体），
+ * 把机器人挂到这块的入口上；每个人也在自己的块里挂上去，然后在抽象图上 A*。
+ * 只细化第一段：从机器人走到路径上第一个入口的那几步，其余的不展开。
+ * 块内路径不许出块，所以结果是近似最短路，换来的是每步只碰一小块格子。
+ *
+ * 格子被挡住 / 放开时只把它所在的块（在边上的话还有隔壁块）标脏，
+ * 下次查询前重算这些块的入口和块内距离，其他块不动。
+ * blocked 是计数，语义和 distfield 一样。
+ */
+
+#define HPA_CLUSTER  16
+#define HPA_MAX_ENT  (HPA_CLUSTER / 2)      // 一条边界最多几个入口
+#define HPA_SLOTS    (4 * HPA_MAX_ENT)      // 一块最多几个入口（四条边）
+
+typedef struct {
+    int w, h;
+    int ncx, ncy;               // 横竖各几块
+    int n_vborders;             // 竖边界（左右两块之间）个数，后面接着横边界
+    int n_borders;
+    int n_nodes;                // n_borders * HPA_MAX_ENT * 2（没用上的入口空着）
+
+    unsigned char  *blocked;    // [w*h] 计数
+
+    unsigned char  *ent_count;  // [n_borders]
+    int            *ent_cell;   // [n_borders * HPA_MAX_ENT]，入口在编号小的那块里的格子
+    unsigned short *cl_dist;    // [块数 * HPA_SLOTS * HPA_SLOTS]，块内入口两两距离
+
+    /* 脏的边界 / 块，查询前重算 */
+    unsigned char  *border_dirty;
+    unsigned char  *cluster_dirty;
+    int            *dirty_borders;
+    int             n_dirty_borders;
+    int            *dirty_clusters;
+    int             n_dirty_clusters;
+
+    /* A* 用 */
+    unsigned int   *g;
+    int            *parent;
+    unsigned int   *seen;       // 按 stamp 比较
+    unsigned short *goal_cost;  // 从这个入口走到某个人的块内步数
+    unsigned int   *goal_seen;
+    unsigned int    stamp;
+    unsigned long long *heap;   // f << 32 | 节点
+    int             heap_len;
+    int             heap_cap;
+
+    /* 块内 BFS 用，各 HPA_CLUSTER² 个 */
+    unsigned short *local_dist;
+    int            *local_prev;
+    unsigned short *start_dist;
+    int            *start_prev;
+    int            *local_queue;
+
+    unsigned long   expanded;   // 累计：块内 BFS 出队的格子 + A* 展开的抽象节点
+    bool            out_of_memory;  // 上一次查询堆扩不动、没算完（返回 false 不代表没路）
+} Hpa;
+
+Hpa *hpa_create(int w, int h);
+void hpa_destroy(Hpa *hpa);
+
+/* 全部放开、全部标脏 */
+void hpa_reset(Hpa *hpa);
+void hpa_block(Hpa *hpa, int x, int y);
+void hpa_unblock(Hpa *hpa, int x, int y);
+
+/*
+ * 从 (sx, sy) 往最近的一个人走的下一步方向（'N'/'S'/'W'/'E'）。
+ * avoid 非空时，机器人所在块里 avoid[c] > 0 的格子也当墙（经典模式的身体）。
+ * 找不到路返回 false；内存不够没算完也返回 false，并置 out_of_memory。
+ */
+bool hpa_next_direction(Hpa *hpa, int sx, int sy,
+                        const int *people_x, const int *people_y, int people_count,
+                        const unsigned short *avoid, char *out_dir);
+
+#endif
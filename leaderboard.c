@@ -0,0 +1,926 @@
+#include "leaderboard.h"
+#include "trace.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* ================== 索引文件布局 ================== */
+
+/*
+ * [IndexHeader]
+ * [区段 A] entry_count  个 IndexEntryRec，按分数降序
+ * [区段 C] player_count 个 IndexPlayerRec，按个人最好成绩降序
+ * [区段 B] bucket_count 个 int32 槽，存区段 C 的下标，-1 为空（开放寻址）
+ */
+
+#define INDEX_MAGIC    0x424C4252u   /* "RBLB" */
+#define INDEX_VERSION  2
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int64_t  src_size;
+    int64_t  src_mtime;
+    int32_t  entry_count;
+    int32_t  player_count;
+    int32_t  bucket_count;
+    int32_t  src_mtime_ns;      // 同一秒里改过两次、大小又没变也认得出来
+} IndexHeader;
+
+typedef struct {
+    char    name[MAX_NAME + 1];
+    char    pad[3];
+    int32_t score;
+    int32_t level;
+} IndexEntryRec;
+
+typedef struct {
+    char    name[MAX_NAME + 1];
+    char    pad[3];
+    int32_t best_score;
+    int32_t best_level;
+    int32_t games;
+} IndexPlayerRec;
+
+/* mtime 的纳秒部分；没有的平台记 0，只能靠秒和大小 */
+static int32_t mtime_ns(const struct stat *st) {
+#if defined(_WIN32)
+    (void)st;
+    return 0;
+#elif defined(__APPLE__)
+    return (int32_t)st->st_mtimespec.tv_nsec;
+#else
+    return (int32_t)st->st_mtim.tv_nsec;
+#endif
+}
+
+#define OFF_ENTRIES(idx)  ((long)sizeof(IndexHeader))
+#define OFF_PLAYERS(idx)  (OFF_ENTRIES(idx) + (long)(idx)->entry_count * (long)sizeof(IndexEntryRec))
+#define OFF_BUCKETS(idx)  (OFF_PLAYERS(idx) + (long)(idx)->player_count * (long)sizeof(IndexPlayerRec))
+
+/* ================== 排序 & 哈希 ================== */
+
+int compare_scores_desc(const void *a, const void *b) {
+    const LeaderboardEntry *ea = (const LeaderboardEntry *)a;
+    const LeaderboardEntry *eb = (const LeaderboardEntry *)b;
+    return (ea->score < eb->score) - (ea->score > eb->score);
+}
+
+static int compare_ints_desc(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x < y) - (x > y);
+}
+
+static int compare_players_desc(const void *a, const void *b) {
+    const IndexPlayerRec *pa = (const IndexPlayerRec *)a;
+    const IndexPlayerRec *pb = (const IndexPlayerRec *)b;
+    if (pa->best_score != pb->best_score)
+        return (pa->best_score < pb->best_score) - (pa->best_score > pb->best_score);
+    return strcmp(pa->name, pb->name);
+}
+
+/* FNV-1a */
+static uint32_t hash_name(const char *name) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* ================== 读写 leaderboard.txt ================== */
+
+/* 旧的 fscanf 读法：保留作回退路径（不能 mmap 的平台/文件）和基准对照 */
+int leaderboard_load_stdio(const char *path, LeaderboardEntry **out) {
+    LeaderboardEntry *entries = NULL;
+    int count = 0, cap = 0;
+
+    *out = NULL;
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+
+    char name_buf[MAX_NAME + 1];
+    int score, level;
+    while (fscanf(f, "%20s %d %d", name_buf, &score, &level) == 3) {
+        if (count >= cap) {
+            int new_cap = (cap == 0) ? 16 : cap * 2;
+            LeaderboardEntry *p = realloc(entries, sizeof(LeaderboardEntry) * new_cap);
+            if (!p) break;
+            entries = p;
+            cap = new_cap;
+        }
+        strncpy(entries[count].name, name_buf, MAX_NAME);
+        entries[count].name[MAX_NAME] = '\0';
+        entries[count].score = score;
+        entries[count].level = level;
+        count++;
+    }
+    fclose(f);
+
+    *out = entries;
+    return count;
+}
+
+/* ---- 换行扫描：一次比较 16/32 个字节 ---- */
+
+static const char *find_newline(const char *p, const char *end) {
+#if defined(__AVX2__)
+    const __m256i nl32 = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl32));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i nl16 = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl16));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#endif
+    const char *q = memchr(p, '\n', (size_t)(end - p));
+    return q ? q : end;
+}
+
+static size_t count_newlines(const char *p, const char *end) {
+    size_t n = 0;
+#if defined(__AVX2__)
+    const __m256i nl32 = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)p);
+        n += (size_t)__builtin_popcount((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl32)));
+        p += 32;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i nl16 = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        n += (size_t)__builtin_popcount((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl16)));
+        p += 16;
+    }
+#endif
+    for (; p < end; p++) n += (*p == '\n');
+    return n;
+}
+
+/* ---- 单行解析：不经过 stdio / locale ---- */
+
+static bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static bool parse_int(const char **pp, const char *end, int *out) {
+    const char *p = *pp;
+    while (p < end && is_blank(*p)) p++;
+
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) { neg = (*p == '-'); p++; }
+    if (p >= end || *p < '0' || *p > '9') return false;
+
+    /* 超出 int 的卡在 INT_MAX / INT_MIN，不截断成乱七八糟的数 */
+    long long v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (v <= INT_MAX) v = v * 10 + (*p - '0');
+        p++;
+    }
+    if (neg) *out = v > (long long)INT_MAX + 1 ? INT_MIN : (int)-v;
+    else     *out = v > INT_MAX ? INT_MAX : (int)v;
+    *pp = p;
+    return true;
+}
+
+/* 解析 "name score level"；格式不对返回 false（与 fscanf 一样在此停止） */
+static bool parse_line(const char *p, const char *end, LeaderboardEntry *e) {
+    while (p < end && is_blank(*p)) p++;
+
+    int n = 0;
+    while (p < end && !is_blank(*p)) {
+        if (n < MAX_NAME) e->name[n++] = *p;
+        p++;
+    }
+    if (n == 0) return false;
+    e->name[n] = '\0';
+
+    return parse_int(&p, end, &e->score) && parse_int(&p, end, &e->level);
+}
+
+static bool line_is_blank(const char *p, const char *end) {
+    while (p < end && is_blank(*p)) p++;
+    return p == end;
+}
+
+static int parse_buffer(const char *data, size_t size, LeaderboardEntry **out) {
+    const char *p   = data;
+    const char *end = data + size;
+
+    /* 先数行数，一次分配到位，避免 realloc 搬家 */
+    size_t lines = count_newlines(p, end) + 1;
+    if (lines > (size_t)0x7fffffff) lines = 0x7fffffff;
+
+    LeaderboardEntry *entries = malloc(sizeof(LeaderboardEntry) * lines);
+    if (!entries) return 0;
+
+    int count = 0;
+    while (p < end && (size_t)count < lines) {
+        const char *eol = find_newline(p, end);
+        if (!line_is_blank(p, eol)) {
+            if (!parse_line(p, eol, &entries[count])) break;
+            count++;
+        }
+        p = eol + 1;
+    }
+
+    if (count == 0) {
+        free(entries);
+        entries = NULL;
+    }
+    *out = entries;
+    return count;
+}
+
+int leaderboard_load(const char *path, LeaderboardEntry **out) {
+#ifdef _WIN32
+    return leaderboard_load_stdio(path, out);
+#else
+    *out = NULL;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return leaderboard_load_stdio(path, out);
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return leaderboard_load_stdio(path, out);
+
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+    int count = parse_buffer((const char *)map, (size_t)st.st_size, out);
+    munmap(map, (size_t)st.st_size);
+    return count;
+#endif
+}
+
+bool leaderboard_save(const char *path, const LeaderboardEntry *entries, int count) {
+    /* 写临时文件 + fsync + rename：中途退出也不会留下半个排行榜 */
+    char tmp_path[512];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE *f = fopen(tmp_path, "w");
+    if (!f) return false;
+    bool ok = true;
+    for (int i = 0; ok && i < count; i++) {
+        ok = fprintf(f, "%s %d %d\n", entries[i].name, entries[i].score, entries[i].level) > 0;
+    }
+    if (fflush(f) != 0) ok = false;
+#ifndef _WIN32
+    if (ok && fsync(fileno(f)) != 0) ok = false;
+#endif
+    if (fclose(f) != 0) ok = false;
+
+    if (ok) ok = rename(tmp_path, path) == 0;
+    if (!ok) {
+        remove(tmp_path);
+        return false;
+    }
+
+    /* txt 已变，索引下次查询时重建 */
+    char idx_path[512];
+    leaderboard_index_path(path, idx_path, sizeof(idx_path));
+    remove(idx_path);
+    return true;
+}
+
+/* 读入 -> 加一条 -> 排序 -> 写回；result 可为 NULL */
+bool leaderboard_append(const char *path, const LeaderboardEntry *entry,
+                        LeaderboardUpdate *result) {
+    LeaderboardEntry *entries = NULL;
+    int count = leaderboard_load(path, &entries);
+
+    int best_before = -1;
+    for (int i = 0; i < count; i++) {
+        if (entries[i].score > best_before) best_before = entries[i].score;
+    }
+
+    LeaderboardEntry *p = realloc(entries, sizeof(LeaderboardEntry) * (count + 1));
+    if (!p) {
+        free(entries);
+        return false;
+    }
+    entries = p;
+    entries[count++] = *entry;
+    qsort(entries, count, sizeof(LeaderboardEntry), compare_scores_desc);
+
+    bool ok = leaderboard_save(path, entries, count);
+
+    if (result) {
+        result->new_record = (best_before < 0 || entry->score > best_before);
+        result->top_count  = (count < LEADERBOARD_TOP) ? count : LEADERBOARD_TOP;
+        memcpy(result->top, entries, sizeof(LeaderboardEntry) * result->top_count);
+        result->saved = ok;
+    }
+
+    free(entries);
+    return ok;
+}
+
+/* ================== 后台写线程 ================== */
+
+/*
+ * 游戏结束时把成绩丢进一个有界队列，由后台线程完成读/排序/写，
+ * 界面不必等文件 I/O。队列满时 submit 会阻塞（背压），
+ * leaderboard_writer_stop 会等队列清空、全部落盘后才返回。
+ */
+
+#define WRITER_QUEUE_CAP 8
+
+typedef struct {
+    char               path[256];
+    LeaderboardEntry   entry;
+    LeaderboardUpdate *result;
+} WriteJob;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  not_empty;
+    pthread_cond_t  not_full;
+    pthread_cond_t  done;           // 有任务完成（给 flush / wait 用）
+    WriteJob        queue[WRITER_QUEUE_CAP];
+    int             head, count;
+    int             in_flight;
+    bool            running;
+    bool            stopping;
+    pthread_t       thread;
+} writer = {
+    .lock      = PTHREAD_MUTEX_INITIALIZER,
+    .not_empty = PTHREAD_COND_INITIALIZER,
+    .not_full  = PTHREAD_COND_INITIALIZER,
+    .done      = PTHREAD_COND_INITIALIZER,
+};
+
+static void *writer_main(void *arg) {
+    (void)arg;
+    trace_thread_name("leaderboard_writer");
+    pthread_mutex_lock(&writer.lock);
+    for (;;) {
+        while (writer.count == 0 && !writer.stopping)
+            pthread_cond_wait(&writer.not_empty, &writer.lock);
+        if (writer.count == 0 && writer.stopping) break;
+
+        WriteJob job = writer.queue[writer.head];
+        writer.head = (writer.head + 1) % WRITER_QUEUE_CAP;
+        writer.count--;
+        writer.in_flight++;
+        pthread_cond_signal(&writer.not_full);
+        pthread_mutex_unlock(&writer.lock);
+
+        /* 结果先写到局部变量，完成后在锁内一次性交给调用者 */
+        LeaderboardUpdate local = {0};
+        TRACE_BEGIN("leaderboard_append");
+        leaderboard_append(job.path, &job.entry, job.result ? &local : NULL);
+        TRACE_END("leaderboard_append");
+
+        pthread_mutex_lock(&writer.lock);
+        if (job.result) {
+            local.ready = true;
+            *job.result = local;
+        }
+        writer.in_flight--;
+        pthread_cond_broadcast(&writer.done);
+    }
+    pthread_mutex_unlock(&writer.lock);
+    return NULL;
+}
+
+bool leaderboard_writer_start(void) {
+    pthread_mutex_lock(&writer.lock);
+    bool ok = writer.running;
+    if (!ok) {
+        writer.head = writer.count = writer.in_flight = 0;
+        writer.stopping = false;
+        ok = pthread_create(&writer.thread, NULL, writer_main, NULL) == 0;
+        writer.running = ok;
+    }
+    pthread_mutex_unlock(&writer.lock);
+    return ok;
+}
+
+void leaderboard_submit(const char *path, const LeaderboardEntry *entry,
+                        LeaderboardUpdate *result) {
+    if (result) memset(result, 0, sizeof(*result));
+
+    pthread_mutex_lock(&writer.lock);
+    if (!writer.running) {
+        /* 没有后台线程（没启动或启动失败）：当场同步写 */
+        pthread_mutex_unlock(&writer.lock);
+        LeaderboardUpdate local = {0};
+        leaderboard_append(path, entry, result ? &local : NULL);
+        if (result) {
+            local.ready = true;
+            *result = local;
+        }
+        return;
+    }
+
+    while (writer.count == WRITER_QUEUE_CAP)
+        pthread_cond_wait(&writer.not_full, &writer.lock);
+
+    WriteJob *job = &writer.queue[(writer.head + writer.count) % WRITER_QUEUE_CAP];
+    snprintf(job->path, sizeof(job->path), "%s", path);
+    job->entry  = *entry;
+    job->result = result;
+    writer.count++;
+    pthread_cond_signal(&writer.not_empty);
+    pthread_mutex_unlock(&writer.lock);
+}
+
+bool leaderboard_update_ready(LeaderboardUpdate *result) {
+    pthread_mutex_lock(&writer.lock);
+    bool ready = result->ready;
+    pthread_mutex_unlock(&writer.lock);
+    return ready;
+}
+
+void leaderboard_update_wait(LeaderboardUpdate *result) {
+    pthread_mutex_lock(&writer.lock);
+    while (!result->ready)
+        pthread_cond_wait(&writer.done, &writer.lock);
+    pthread_mutex_unlock(&writer.lock);
+}
+
+void leaderboard_writer_flush(void) {
+    pthread_mutex_lock(&writer.lock);
+    while (writer.count > 0 || writer.in_flight > 0)
+        pthread_cond_wait(&writer.done, &writer.lock);
+    pthread_mutex_unlock(&writer.lock);
+}
+
+void leaderboard_writer_stop(void) {
+    pthread_mutex_lock(&writer.lock);
+    if (!writer.running) {
+        pthread_mutex_unlock(&writer.lock);
+        return;
+    }
+    writer.stopping = true;
+    pthread_cond_signal(&writer.not_empty);
+    pthread_mutex_unlock(&writer.lock);
+
+    /* 线程会先把队列里剩下的都写完再退出 */
+    pthread_join(writer.thread, NULL);
+
+    pthread_mutex_lock(&writer.lock);
+    writer.running = false;
+    pthread_mutex_unlock(&writer.lock);
+}
+
+/* ================== 名次表：启动时后台预载 ================== */
+
+static void *rank_table_main(void *arg) {
+    RankTable *t = (RankTable *)arg;
+    trace_thread_name("rank_loader");
+
+    TRACE_BEGIN("rank_table_load");
+    LeaderboardEntry *entries = NULL;
+    int count = leaderboard_load(t->path, &entries);
+
+    int *scores = (count > 0) ? malloc(sizeof(int) * count) : NULL;
+    if (!scores) count = 0;
+
+    bool sorted = true;
+    for (int i = 0; i < count; i++) {
+        scores[i] = entries[i].score;
+        if (i > 0 && scores[i] > scores[i - 1]) sorted = false;
+    }
+    free(entries);
+
+    /* 文件本来就是降序写的，一般不需要再排 */
+    if (!sorted) qsort(scores, count, sizeof(int), compare_ints_desc);
+
+    t->scores = scores;
+    t->count  = count;
+    TRACE_END("rank_table_load");
+    atomic_store_explicit(&t->ready, true, memory_order_release);
+    return NULL;
+}
+
+bool rank_table_load_async(RankTable *t, const char *path) {
+    memset(t, 0, sizeof(*t));
+    snprintf(t->path, sizeof(t->path), "%s", path);
+    atomic_init(&t->ready, false);
+
+    t->started = pthread_create(&t->thread, NULL, rank_table_main, t) == 0;
+    if (!t->started) rank_table_main(t);   // 起不了线程就同步读
+    return true;
+}
+
+bool rank_table_ready(const RankTable *t) {
+    return atomic_load_explicit(&t->ready, memory_order_acquire);
+}
+
+int rank_table_rank(const RankTable *t, int score) {
+    if (!rank_table_ready(t)) return 0;
+
+    /* 二分：第一个 <= score 的位置就是比它高的人数 */
+    int lo = 0, hi = t->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (t->scores[mid] > score) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo + 1;
+}
+
+void rank_table_free(RankTable *t) {
+    if (t->started) pthread_join(t->thread, NULL);
+    t->started = false;
+    free(t->scores);
+    t->scores = NULL;
+    t->count  = 0;
+}
+
+/* ================== 建索引 ================== */
+
+static bool build_index(const char *txt_path, const char *idx_path,
+                        const struct stat *src) {
+    LeaderboardEntry *entries = NULL;
+    int count = leaderboard_load(txt_path, &entries);
+
+    if (count > 0) qsort(entries, count, sizeof(LeaderboardEntry), compare_scores_desc);
+
+    int32_t buckets = 16;
+    while (buckets < count * 2) buckets *= 2;
+
+    int32_t *slots = malloc(sizeof(int32_t) * buckets);
+    IndexPlayerRec *players = calloc(count > 0 ? count : 1, sizeof(IndexPlayerRec));
+    if (!slots || !players) {
+        free(slots); free(players); free(entries);
+        return false;
+    }
+    for (int i = 0; i < buckets; i++) slots[i] = -1;
+
+    /* 按名字聚合：每人最好成绩 + 局数 */
+    int player_count = 0;
+    for (int i = 0; i < count; i++) {
+        uint32_t h = hash_name(entries[i].name) & (uint32_t)(buckets - 1);
+        while (slots[h] != -1 && strcmp(players[slots[h]].name, entries[i].name) != 0) {
+            h = (h + 1) & (uint32_t)(buckets - 1);
+        }
+        if (slots[h] == -1) {
+            IndexPlayerRec *p = &players[player_count];
+            strncpy(p->name, entries[i].name, MAX_NAME);
+            p->best_score = entries[i].score;
+            p->best_level = entries[i].level;
+            slots[h] = player_count++;
+        } else if (entries[i].score > players[slots[h]].best_score) {
+            players[slots[h]].best_score = entries[i].score;
+            players[slots[h]].best_level = entries[i].level;
+        }
+        players[slots[h]].games++;
+    }
+
+    /* 排序后槽里的下标会变，按新顺序重建哈希表 */
+    qsort(players, player_count, sizeof(IndexPlayerRec), compare_players_desc);
+    for (int i = 0; i < buckets; i++) slots[i] = -1;
+    for (int i = 0; i < player_count; i++) {
+        uint32_t h = hash_name(players[i].name) & (uint32_t)(buckets - 1);
+        while (slots[h] != -1) h = (h + 1) & (uint32_t)(buckets - 1);
+        slots[h] = i;
+    }
+
+    bool ok = false;
+    char tmp_path[512];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", idx_path);
+
+    FILE *f = fopen(tmp_path, "wb");
+    if (f) {
+        IndexHeader hdr = {0};
+        hdr.magic        = INDEX_MAGIC;
+        hdr.version      = INDEX_VERSION;
+        hdr.src_size     = src ? (int64_t)src->st_size  : -1;
+        hdr.src_mtime    = src ? (int64_t)src->st_mtime : -1;
+        hdr.src_mtime_ns = src ? mtime_ns(src) : -1;
+        hdr.entry_count  = count;
+        hdr.player_count = player_count;
+        hdr.bucket_count = buckets;
+
+        ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+        for (int i = 0; ok && i < count; i++) {
+            IndexEntryRec rec = {0};
+            memcpy(rec.name, entries[i].name, sizeof(rec.name));
+            rec.score = entries[i].score;
+            rec.level = entries[i].level;
+            ok = fwrite(&rec, sizeof(rec), 1, f) == 1;
+        }
+        if (ok && player_count > 0)
+            ok = fwrite(players, sizeof(IndexPlayerRec), player_count, f) == (size_t)player_count;
+        if (ok)
+            ok = fwrite(slots, sizeof(int32_t), buckets, f) == (size_t)buckets;
+        if (fclose(f) != 0) ok = false;
+
+        /* 先写临时文件再改名，查询方不会读到写了一半的索引 */
+        if (ok) ok = rename(tmp_path, idx_path) == 0;
+        if (!ok) remove(tmp_path);
+    }
+
+    free(slots);
+    free(players);
+    free(entries);
+    return ok;
+}
+
+/* ================== 打开 / 查询索引 ================== */
+
+static bool read_at(FILE *f, long off, void *buf, size_t size, size_t n) {
+    if (fseek(f, off, SEEK_SET) != 0) return false;
+    return fread(buf, size, n, f) == n;
+}
+
+static bool try_open_index(LeaderboardIndex *idx, const char *idx_path,
+                           const struct stat *src) {
+    FILE *f = fopen(idx_path, "rb");
+    if (!f) return false;
+
+    IndexHeader hdr;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1 ||
+        hdr.magic != INDEX_MAGIC || hdr.version != INDEX_VERSION ||
+        hdr.src_size  != (src ? (int64_t)src->st_size  : -1) ||
+        hdr.src_mtime != (src ? (int64_t)src->st_mtime : -1) ||
+        hdr.src_mtime_ns != (src ? mtime_ns(src) : -1)) {
+        fclose(f);
+        return false;
+    }
+
+    idx->f            = f;
+    idx->entry_count  = hdr.entry_count;
+    idx->player_count = hdr.player_count;
+    idx->bucket_count = hdr.bucket_count;
+    return true;
+}
+
+void leaderboard_index_path(const char *txt_path, char *buf, size_t size) {
+    snprintf(buf, size, "%s.idx", txt_path);
+}
+
+bool leaderboard_index_open(LeaderboardIndex *idx,
+                            const char *txt_path, const char *idx_path) {
+    memset(idx, 0, sizeof(*idx));
+
+    struct stat st;
+    const struct stat *src = (stat(txt_path, &st) == 0) ? &st : NULL;
+
+    if (try_open_index(idx, idx_path, src)) return true;
+    if (!build_index(txt_path, idx_path, src)) return false;
+    return try_open_index(idx, idx_path, src);
+}
+
+void leaderboard_index_close(LeaderboardIndex *idx) {
+    if (idx->f) fclose(idx->f);
+    idx->f = NULL;
+}
+
+int leaderboard_index_top(LeaderboardIndex *idx, int offset, int n,
+                          LeaderboardEntry *out) {
+    if (offset < 0 || offset >= idx->entry_count || n <= 0) return 0;
+    if (n > idx->entry_count - offset) n = idx->entry_count - offset;
+
+    if (fseek(idx->f, OFF_ENTRIES(idx) + (long)offset * (long)sizeof(IndexEntryRec),
+              SEEK_SET) != 0)
+        return 0;
+
+    int got = 0;
+    IndexEntryRec rec;
+    while (got < n && fread(&rec, sizeof(rec), 1, idx->f) == 1) {
+        memcpy(out[got].name, rec.name, sizeof(out[got].name));
+        out[got].name[MAX_NAME] = '\0';
+        out[got].score = rec.score;
+        out[got].level = rec.level;
+        got++;
+    }
+    return got;
+}
+
+int leaderboard_index_rank(LeaderboardIndex *idx, int score) {
+    /* 二分：找第一个分数 <= score 的位置，前面的人都比它高 */
+    int lo = 0, hi = idx->entry_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        IndexEntryRec rec;
+        if (!read_at(idx->f, OFF_ENTRIES(idx) + (long)mid * (long)sizeof(rec),
+                     &rec, sizeof(rec), 1))
+            return -1;
+        if (rec.score > score) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo + 1;
+}
+
+static void player_from_rec(PlayerBest *out, const IndexPlayerRec *rec) {
+    memcpy(out->name, rec->name, sizeof(out->name));
+    out->name[MAX_NAME] = '\0';
+    out->best_score = rec->best_score;
+    out->best_level = rec->best_level;
+    out->games      = rec->games;
+}
+
+bool leaderboard_index_player(LeaderboardIndex *idx, const char *name,
+                              PlayerBest *out) {
+    if (idx->bucket_count <= 0) return false;
+
+    uint32_t mask = (uint32_t)(idx->bucket_count - 1);
+    uint32_t h = hash_name(name) & mask;
+
+    for (int probes = 0; probes < idx->bucket_count; probes++) {
+        int32_t slot;
+        if (!read_at(idx->f, OFF_BUCKETS(idx) + (long)h * (long)sizeof(slot),
+                     &slot, sizeof(slot), 1))
+            return false;
+        if (slot < 0) return false;
+
+        IndexPlayerRec rec;
+        if (!read_at(idx->f, OFF_PLAYERS(idx) + (long)slot * (long)sizeof(rec),
+                     &rec, sizeof(rec), 1))
+            return false;
+        rec.name[MAX_NAME] = '\0';
+        if (strcmp(rec.name, name) == 0) {
+            player_from_rec(out, &rec);
+            return true;
+        }
+        h = (h + 1) & mask;
+    }
+    return false;
+}
+
+int leaderboard_index_players(LeaderboardIndex *idx, int offset, int n,
+                              PlayerBest *out) {
+    if (offset < 0 || offset >= idx->player_count || n <= 0) return 0;
+    if (n > idx->player_count - offset) n = idx->player_count - offset;
+
+    if (fseek(idx->f, OFF_PLAYERS(idx) + (long)offset * (long)sizeof(IndexPlayerRec),
+              SEEK_SET) != 0)
+        return 0;
+
+    int got = 0;
+    IndexPlayerRec rec;
+    while (got < n && fread(&rec, sizeof(rec), 1, idx->f) == 1) {
+        player_from_rec(&out[got], &rec);
+        got++;
+    }
+    return got;
+}
+
+/* ================== 命令行查询 ================== */
+
+static void print_usage(void) {
+    printf("Usage:\n");
+    printf("  game --leaderboard top [N] [PAGE]      top N scores, page PAGE (default 10 1)\n");
+    printf("  game --leaderboard rank SCORE          rank a score would get\n");
+    printf("  game --leaderboard best NAME           best score of one player\n");
+    printf("  game --leaderboard players [N] [PAGE]  best score per player, paged\n");
+}
+
+static int arg_int(int argc, char **argv, int i, int def) {
+    if (i >= argc) return def;
+    int v = atoi(argv[i]);
+    return v > 0 ? v : def;
+}
+
+/* 每页条数最多 total 条（至少 1），不然页码乘上去会溢出、malloc 也白要一大块 */
+static int clamp_per_page(int per_page, int total) {
+    if (per_page > total) per_page = total;
+    return per_page < 1 ? 1 : per_page;
+}
+
+/* 第 page 页的第一条的下标；用 long 算，超出 total 时调用方不去查 */
+static long page_offset(int page, int per_page) {
+    return (long)(page - 1) * per_page;
+}
+
+static void print_page_footer(int page, int per_page, int total, int shown) {
+    int pages = (total + per_page - 1) / per_page;
+    if (pages < 1) pages = 1;
+    long first = page_offset(page, per_page) + 1;
+    if (shown == 0)
+        printf("Page %d/%d (no entries, %d total)\n", page, pages, total);
+    else
+        printf("Page %d/%d (%ld-%ld of %d)\n", page, pages,
+               first, first + shown - 1, total);
+}
+
+int leaderboard_cli(int argc, char **argv) {
+    const char *cmd = (argc > 0) ? argv[0] : "top";
+
+    LeaderboardIndex idx;
+    char idx_path[512];
+    leaderboard_index_path(LEADERBOARD_FILE, idx_path, sizeof(idx_path));
+    if (!leaderboard_index_open(&idx, LEADERBOARD_FILE, idx_path)) {
+        fprintf(stderr, "Cannot open or build %s\n", idx_path);
+        return 1;
+    }
+
+    int rc = 0;
+
+    if (strcmp(cmd, "top") == 0) {
+        int per_page = clamp_per_page(arg_int(argc, argv, 1, 10), idx.entry_count);
+        int page     = arg_int(argc, argv, 2, 1);
+
+        LeaderboardEntry *buf = malloc(sizeof(LeaderboardEntry) * per_page);
+        if (!buf) {
+            fprintf(stderr, "out of memory\n");
+            leaderboard_index_close(&idx);
+            return 1;
+        }
+
+        long offset = page_offset(page, per_page);
+        int n = offset < idx.entry_count
+              ? leaderboard_index_top(&idx, (int)offset, per_page, buf) : 0;
+
+        printf("Rank  Name                  Level  Score\n");
+        printf("----------------------------------------\n");
+        for (int i = 0; i < n; i++) {
+            printf("%4ld  %-20s  %5d  %5d\n",
+                   offset + i + 1, buf[i].name, buf[i].level, buf[i].score);
+        }
+        print_page_footer(page, per_page, idx.entry_count, n);
+        free(buf);
+    }
+    else if (strcmp(cmd, "rank") == 0 && argc >= 2) {
+        int score = atoi(argv[1]);
+        int rank  = leaderboard_index_rank(&idx, score);
+        if (rank < 0) rc = 1;
+        else printf("Score %d ranks #%d of %d\n", score, rank, idx.entry_count + 1);
+    }
+    else if (strcmp(cmd, "best") == 0 && argc >= 2) {
+        PlayerBest pb;
+        if (leaderboard_index_player(&idx, argv[1], &pb)) {
+            int rank = leaderboard_index_rank(&idx, pb.best_score);
+            printf("%s: best %d (level %d), %d game(s), rank #%d\n",
+                   pb.name, pb.best_score, pb.best_level, pb.games, rank);
+        } else {
+            printf("No records for %s\n", argv[1]);
+            rc = 1;
+        }
+    }
+    else if (strcmp(cmd, "players") == 0) {
+        int per_page = clamp_per_page(arg_int(argc, argv, 1, 10), idx.player_count);
+        int page     = arg_int(argc, argv, 2, 1);
+
+        PlayerBest *buf = malloc(sizeof(PlayerBest) * per_page);
+        if (!buf) {
+            fprintf(stderr, "out of memory\n");
+            leaderboard_index_close(&idx);
+            return 1;
+        }
+
+        long offset = page_offset(page, per_page);
+        int n = offset < idx.player_count
+              ? leaderboard_index_players(&idx, (int)offset, per_page, buf) : 0;
+
+        printf("Rank  Name                  Level  Score  Games\n");
+        printf("-----------------------------------------------\n");
+        for (int i = 0; i < n; i++) {
+            printf("%4ld  %-20s  %5d  %5d  %5d\n",
+                   offset + i + 1, buf[i].name, buf[i].best_level,
+                   buf[i].best_score, buf[i].games);
+        }
+        print_page_footer(page, per_page, idx.player_count, n);
+        free(buf);
+    }
+    else {
+        print_usage();
+        rc = 2;
+    }
+
+    leaderboard_index_close(&idx);
+    return rc;
+}
@@ -0,0 +1,119 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* ================== 排行榜：文件格式与索引 ================== */
+
+/*
+ * leaderboard.txt 每行一条记录：name score level
+ * leaderboard.txt.idx 是由 leaderboard.txt 生成的二进制索引（txt 路径后加 .idx），
+ * 按分数降序存放全部成绩，并带一张按名字哈希的“个人最好成绩”表，
+ * 查询时只按偏移读需要的几条记录，不必把整个文件读进内存。
+ */
+
+#ifndef MAX_NAME
+#define MAX_NAME 20
+#endif
+
+#define LEADERBOARD_FILE   "leaderboard.txt"
+#define LEADERBOARD_TOP    10
+
+typedef struct {
+    char name[MAX_NAME + 1];
+    int  score;
+    int  level;
+} LeaderboardEntry;
+
+/* 按名字聚合后的个人最好成绩 */
+typedef struct {
+    char name[MAX_NAME + 1];
+    int  best_score;
+    int  best_level;
+    int  games;
+} PlayerBest;
+
+/* 一次“加入成绩”的结果：排序后的前几名 + 是否破纪录 */
+typedef struct {
+    LeaderboardEntry top[LEADERBOARD_TOP];
+    int  top_count;
+    bool new_record;
+    bool saved;      // 是否成功写回文件
+    bool ready;      // 后台线程已完成
+} LeaderboardUpdate;
+
+typedef struct {
+    FILE   *f;
+    int32_t entry_count;    // 全部成绩条数
+    int32_t player_count;   // 不同名字的玩家数
+    int32_t bucket_count;   // 哈希表槽数（2 的幂）
+} LeaderboardIndex;
+
+/* 只存分数的降序数组，给游戏中“实时名次”做二分查找 */
+typedef struct {
+    char        path[256];
+    int        *scores;
+    int         count;
+    atomic_bool ready;     // 后台读完后置 true，之后 scores/count 只读
+    bool        started;
+    pthread_t   thread;
+} RankTable;
+
+int  compare_scores_desc(const void *a, const void *b);
+
+/* 读取全部记录，返回条数；*out 由调用者 free（mmap + SIMD 找换行） */
+int  leaderboard_load(const char *path, LeaderboardEntry **out);
+/* 同上，逐条 fscanf 的旧实现 */
+int  leaderboard_load_stdio(const char *path, LeaderboardEntry **out);
+/* 整体写回（临时文件 + fsync + rename），并让旧索引失效 */
+bool leaderboard_save(const char *path, const LeaderboardEntry *entries, int count);
+/* 同步：读入、加一条、排序、写回 */
+bool leaderboard_append(const char *path, const LeaderboardEntry *entry,
+                        LeaderboardUpdate *result);
+
+/* 后台写线程：submit 立即返回，result 在完成后 ready=true */
+bool leaderboard_writer_start(void);
+void leaderboard_submit(const char *path, const LeaderboardEntry *entry,
+                        LeaderboardUpdate *result);
+bool leaderboard_update_ready(LeaderboardUpdate *result);
+void leaderboard_update_wait(LeaderboardUpdate *result);
+/* 等所有排队的写入落盘 */
+void leaderboard_writer_flush(void);
+/* flush 后结束线程 */
+void leaderboard_writer_stop(void);
+
+/* txt_path 对应的索引文件名："<txt_path>.idx" */
+void leaderboard_index_path(const char *txt_path, char *buf, size_t size);
+
+/* 打开索引；索引不存在或比 txt 旧时自动重建 */
+bool leaderboard_index_open(LeaderboardIndex *idx,
+                            const char *txt_path, const char *idx_path);
+void leaderboard_index_close(LeaderboardIndex *idx);
+
+/* 从第 offset 名开始读 n 条（按分数降序），返回实际读到的条数 */
+int  leaderboard_index_top(LeaderboardIndex *idx, int offset, int n,
+                           LeaderboardEntry *out);
+/* 分数 score 能排第几名（1 起，并列算同一名） */
+int  leaderboard_index_rank(LeaderboardIndex *idx, int score);
+/* 按名字查个人最好成绩 */
+bool leaderboard_index_player(LeaderboardIndex *idx, const char *name,
+                              PlayerBest *out);
+/* 按个人最好成绩降序，从 offset 开始读 n 个玩家 */
+int  leaderboard_index_players(LeaderboardIndex *idx, int offset, int n,
+                               PlayerBest *out);
+
+/* 后台线程读入排行榜分数；读完之前 rank 返回 0 */
+bool rank_table_load_async(RankTable *t, const char *path);
+bool rank_table_ready(const RankTable *t);
+/* score 在已有成绩中的名次（1 起，并列算同一名） */
+int  rank_table_rank(const RankTable *t, int score);
+void rank_table_free(RankTable *t);
+
+/* 命令行：game --leaderboard <top|rank|best|players> ... */
+int  leaderboard_cli(int argc, char **argv);
+
+#endif
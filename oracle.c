@@ -0,0 +1,293 @@
+#include "oracle.h"
+#include "threadpool.h"
+#include "trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/* ================== 后台重算线程（全进程一个） ================== */
+
+/*
+ * 所有表共用一个后台线程和一个线程池：同一个池不能被两个线程同时 pool_run，
+ * 只让后台线程去 run 就不用再加锁。第一次 oracle_create 时起，之后一直留着。
+ * 队列里一张表最多出现一次，算的总是它最近一次 request 的那份快照。
+ */
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  work;           // 队列里来了活
+    pthread_cond_t  done;           // 有表算完（给 wait / destroy 用）
+    bool            running;
+    pthread_t       thread;
+    DistOracle     *head, *tail;
+
+    /* 下面只有后台线程自己用 */
+    ThreadPool     *pool;
+    int             chunks;         // 并行时切几份
+    int            *offset;         // 正在算的图快照
+    int            *edge;
+    int             cap;            // offset / edge 按 cap 个格子分配
+    int            *queues;         // [chunks * cap]，每份自己的 BFS 队列
+} builder = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+typedef struct {
+    const int      *offset;
+    const int      *edge;
+    int             n;
+    unsigned short *table;
+} Build;
+
+/* 第 k 份：起点 k, k + chunks, k + 2*chunks … 各做一次 BFS，写自己那几行 */
+static void rebuild_chunk(void *ctx, int k) {
+    const Build *b = ctx;
+    const int *offset = b->offset;
+    const int *edge   = b->edge;
+    int n = b->n;
+    int *queue = builder.queues + (size_t)k * builder.cap;
+
+    for (int s = k; s < n; s += builder.chunks) {
+        unsigned short *row = b->table + (size_t)s * n;
+        for (int i = 0; i < n; i++) row[i] = ORACLE_INF;
+
+        int front = 0, back = 0;
+        row[s] = 0;
+        queue[back++] = s;
+        while (front < back) {
+            int u = queue[front++];
+            unsigned short next = row[u] + 1;
+            for (int e = offset[u]; e < offset[u + 1]; e++) {
+                int v = edge[e];
+                if (row[v] != ORACLE_INF) continue;
+                row[v] = next;
+                queue[back++] = v;
+            }
+        }
+    }
+}
+
+/* 后台线程的快照和队列至少能装 n 个格子；锁内调用 */
+static bool reserve_work(int n) {
+    if (n <= builder.cap) return true;
+    int *offset = malloc((size_t)(n + 1) * sizeof(int));
+    int *edge   = malloc((size_t)n * 4 * sizeof(int));
+    int *queues = malloc((size_t)builder.chunks * n * sizeof(int));
+    if (!offset || !edge || !queues) {
+        free(offset);
+        free(edge);
+        free(queues);
+        return false;
+    }
+    free(builder.offset);
+    free(builder.edge);
+    free(builder.queues);
+    builder.offset = offset;
+    builder.edge   = edge;
+    builder.queues = queues;
+    builder.cap    = n;
+    return true;
+}
+
+/* back 至少能装 n × n；busy 期间 back 归后台线程，不用锁 */
+static bool reserve_back(DistOracle *oracle, int n) {
+    if (n <= oracle->back_cap) return true;
+    unsigned short *table = malloc((size_t)n * n * sizeof(unsigned short));
+    if (!table) return false;
+    free(oracle->back);
+    oracle->back = table;
+    oracle->back_cap = n;
+    return true;
+}
+
+static void *builder_main(void *arg) {
+    (void)arg;
+    trace_thread_name("oracle_builder");
+    pthread_mutex_lock(&builder.lock);
+    for (;;) {
+        while (!builder.head)
+            pthread_cond_wait(&builder.work, &builder.lock);
+
+        DistOracle *oracle = builder.head;
+        builder.head = oracle->next;
+        if (!builder.head) builder.tail = NULL;
+        oracle->next   = NULL;
+        oracle->queued = false;
+        oracle->busy   = true;
+        oracle->ready  = false;     // back 要被覆盖了
+
+        unsigned int version = oracle->want;
+        int n = oracle->snap_n;
+        bool ok = n <= ORACLE_MAX_CELLS && reserve_work(n);
+        if (ok) {
+            memcpy(builder.offset, oracle->snap_offset, (size_t)(n + 1) * sizeof(int));
+            memcpy(builder.edge, oracle->snap_edge,
+                   (size_t)oracle->snap_offset[n] * sizeof(int));
+        }
+        pthread_mutex_unlock(&builder.lock);
+
+        if (ok) ok = reserve_back(oracle, n);
+        if (ok) {
+            TRACE_BEGIN("oracle_rebuild");
+            Build b = { builder.offset, builder.edge, n, oracle->back };
+            pool_run(builder.pool, rebuild_chunk, &b, builder.chunks);
+            TRACE_END("oracle_rebuild");
+        }
+
+        pthread_mutex_lock(&builder.lock);
+        oracle->busy = false;
+        if (ok) {
+            oracle->ready        = true;
+            oracle->back_version = version;
+            oracle->back_n       = n;
+        } else if (version == oracle->want) {
+            oracle->failed = true;
+        }
+        pthread_cond_broadcast(&builder.done);
+    }
+    return NULL;
+}
+
+/* 用几个线程：核数，最多 ORACLE_THREADS */
+static int builder_threads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1) n = 1;
+    if (n > ORACLE_THREADS) n = ORACLE_THREADS;
+    return (int)n;
+}
+
+/* 锁内调用 */
+static bool builder_start(void) {
+    if (builder.running) return true;
+    if (!builder.pool) {
+        builder.pool = pool_create(builder_threads());
+        if (!builder.pool) return false;
+        /* 切得比线程数多几份，快的线程多领几份 */
+        int t = pool_threads(builder.pool);
+        builder.chunks = t > 1 ? t * 4 : 1;
+    }
+    builder.running = pthread_create(&builder.thread, NULL, builder_main, NULL) == 0;
+    if (builder.running) pthread_detach(builder.thread);
+    return builder.running;
+}
+
+/* ================== 创建 / 销毁 ================== */
+
+DistOracle *oracle_create(const CellGraph *graph) {
+    pthread_mutex_lock(&builder.lock);
+    bool ok = builder_start();
+    pthread_mutex_unlock(&builder.lock);
+    if (!ok) return NULL;
+
+    DistOracle *oracle = calloc(1, sizeof(DistOracle));
+    if (!oracle) return NULL;
+
+    oracle->graph = graph;
+    size_t cells = (size_t)graph->w * graph->h;
+    oracle->snap_offset = malloc((cells + 1) * sizeof(int));
+    oracle->snap_edge   = malloc(cells * 4 * sizeof(int));
+    if (!oracle->snap_offset || !oracle->snap_edge) {
+        oracle_destroy(oracle);
+        return NULL;
+    }
+    return oracle;
+}
+
+void oracle_destroy(DistOracle *oracle) {
+    if (!oracle) return;
+
+    pthread_mutex_lock(&builder.lock);
+    if (oracle->queued) {
+        DistOracle **link = &builder.head;
+        DistOracle *prev = NULL;
+        while (*link != oracle) {
+            prev = *link;
+            link = &(*link)->next;
+        }
+        *link = oracle->next;
+        if (builder.tail == oracle) builder.tail = prev;
+    }
+    while (oracle->busy)
+        pthread_cond_wait(&builder.done, &builder.lock);
+    pthread_mutex_unlock(&builder.lock);
+
+    free(oracle->table);
+    free(oracle->back);
+    free(oracle->snap_offset);
+    free(oracle->snap_edge);
+    free(oracle);
+}
+
+/* ================== 重算 ================== */
+
+static bool front_fresh(const DistOracle *oracle) {
+    const CellGraph *graph = oracle->graph;
+    return !graph->dirty && oracle->built && oracle->version == graph->version;
+}
+
+void oracle_request(DistOracle *oracle) {
+    const CellGraph *graph = oracle->graph;
+    if (graph->dirty || front_fresh(oracle)) return;
+
+    pthread_mutex_lock(&builder.lock);
+    bool pending = oracle->queued || oracle->busy || oracle->ready || oracle->failed;
+    if (!(pending && oracle->want == graph->version)) {
+        int n = graph->n;
+        oracle->want   = graph->version;
+        oracle->failed = false;
+        oracle->snap_n = n;
+        memcpy(oracle->snap_offset, graph->offset, (size_t)(n + 1) * sizeof(int));
+        memcpy(oracle->snap_edge, graph->edge, (size_t)graph->offset[n] * sizeof(int));
+        if (!oracle->queued) {
+            oracle->queued = true;
+            if (builder.tail) builder.tail->next = oracle;
+            else              builder.head = oracle;
+            builder.tail = oracle;
+            pthread_cond_signal(&builder.work);
+        }
+    }
+    pthread_mutex_unlock(&builder.lock);
+}
+
+bool oracle_ready(DistOracle *oracle) {
+    const CellGraph *graph = oracle->graph;
+    if (graph->dirty) return false;
+    if (front_fresh(oracle)) return true;
+
+    pthread_mutex_lock(&builder.lock);
+    if (oracle->ready && oracle->back_version == graph->version) {
+        /* 后台算好的换到前台，旧的前台表留给下次后台覆盖 */
+        unsigned short *table = oracle->table;
+        int cap = oracle->table_cap;
+        oracle->table     = oracle->back;
+        oracle->table_cap = oracle->back_cap;
+        oracle->back      = table;
+        oracle->back_cap  = cap;
+        oracle->n         = oracle->back_n;
+        oracle->version   = oracle->back_version;
+        oracle->built     = true;
+        oracle->ready     = false;
+    }
+    pthread_mutex_unlock(&builder.lock);
+    return front_fresh(oracle);
+}
+
+bool oracle_wait(DistOracle *oracle) {
+    if (oracle->graph->dirty) return false;
+    if (front_fresh(oracle)) return true;
+
+    pthread_mutex_lock(&builder.lock);
+    while (oracle->queued || oracle->busy)
+        pthread_cond_wait(&builder.done, &builder.lock);
+    pthread_mutex_unlock(&builder.lock);
+    return oracle_ready(oracle);
+}
+
+bool oracle_rebuild(DistOracle *oracle) {
+    oracle_request(oracle);
+    return oracle_wait(oracle);
+}
@@ -0,0 +1,88 @@
+#ifndef ORACLE_H
+#define ORACLE_H
+
+#include <stdbool.h>
+
+#include "graph.h"
+
+/* ================== 任意两格之间的距离表 ================== */
+
+/*
+ * 用能走格子图（graph.h）的编号，存一张 n × n 的 unsigned short 表：
+ * table[a * n + b] = 从 a 走到 b 的最短步数，走不到是 ORACLE_INF。
+ * 默认棋盘 n ≈ 18 × 48 = 864，表约 1.5 MB，查距离就是一次数组访问。
+ *
+ * 图重编过（雷变了）表就过期。重算放在后台：图一重编就 oracle_request，
+ * 把图拍一份快照交给进程里唯一的一个后台线程，它每个格子当一次起点 BFS，
+ * 各行互不相干，按行分给一个全进程共用的线程池（最多 ORACLE_THREADS 个线程）。
+ * 算好的表先放在后备表里，游戏线程 oracle_ready 时才换上来，
+ * 所以查表的时候后台永远不会在写同一张表。
+ */
+
+#define ORACLE_INF        0xFFFF
+#define ORACLE_MAX_CELLS  4096          // 能走的格子超过这么多就不建表（4096² × 2 B = 32 MB）
+
+/* 后台重算最多用几个线程（包括后台线程自己），不超过核数 */
+#ifndef ORACLE_THREADS
+#define ORACLE_THREADS    4
+#endif
+
+typedef struct DistOracle DistOracle;
+
+struct DistOracle {
+    const CellGraph *graph;
+
+    /* 前台：只有游戏线程读写 */
+    unsigned int     version;   // 表是按图的哪一版算的
+    bool             built;
+    int              n;
+    unsigned short  *table;     // [n*n]
+    int              table_cap; // table 按 table_cap² 分配
+
+    /* 以下由后台的锁保护 */
+    unsigned int     want;      // 最近一次 request 的图版本
+    bool             queued;    // 在后台的队列里
+    bool             busy;      // 后台正在算它
+    bool             ready;     // back 算好了，还没换到前台
+    bool             failed;    // want 这一版建不了（格子太多或内存不够）
+    unsigned int     back_version;
+    int              back_n;
+    unsigned short  *back;
+    int              back_cap;
+
+    int              snap_n;    // request 时拍的图快照，后台开算时再拷一份自己用
+    int             *snap_offset;
+    int             *snap_edge;
+    DistOracle      *next;      // 后台队列
+};
+
+/* graph 要比表活得久；第一次调用时起后台线程和线程池，之后一直留着给所有表共用 */
+DistOracle *oracle_create(const CellGraph *graph);
+/* 后台正在算它的话等算完 */
+void        oracle_destroy(DistOracle *oracle);
+
+/* 图刚重编：拍快照交给后台重算，立即返回。图还没重编什么都不做 */
+void oracle_request(DistOracle *oracle);
+/* 不等：后台算好了就换上来。表对得上当前的图返回 true */
+bool oracle_ready(DistOracle *oracle);
+/* 等后台把最近一次 request 算完再 oracle_ready */
+bool oracle_wait(DistOracle *oracle);
+/* request + wait；表已经是新的什么都不做。图还没重编、
+ * 格子超过 ORACLE_MAX_CELLS 或内存不够返回 false */
+bool oracle_rebuild(DistOracle *oracle);
+
+/* 编号 a 到编号 b 的步数 */
+static inline unsigned short oracle_dist_id(const DistOracle *oracle, int a, int b) {
+    return oracle->table[(long)a * oracle->n + b];
+}
+
+/* (ax, ay) 到 (bx, by) 的步数；出界、墙、雷都是 ORACLE_INF。要先 oracle_ready 为 true */
+static inline unsigned short oracle_dist(const DistOracle *oracle,
+                                         int ax, int ay, int bx, int by) {
+    int a = graph_id(oracle->graph, ax, ay);
+    int b = graph_id(oracle->graph, bx, by);
+    if (a < 0 || b < 0) return ORACLE_INF;
+    return oracle_dist_id(oracle, a, b);
+}
+
+#endif
@@ -0,0 +1,113 @@
+#include "perfcounters.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+const char *const PERF_EVENT_NAMES[PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "cache_misses", "branch_misses",
+};
+
+#ifdef __linux__
+
+static const uint64_t PERF_CONFIGS[PERF_EVENT_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+static int open_event(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = config;
+    attr.disabled       = (group_fd == -1);   // 组长先关着，全部打开后一起启用
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+PerfCounters *perf_open(char *err, int err_size) {
+    PerfCounters *pc = calloc(1, sizeof(PerfCounters));
+    if (!pc) {
+        snprintf(err, err_size, "out of memory");
+        return NULL;
+    }
+    pc->group_fd = -1;
+
+    /* 第一个能打开的事件当组长（通常是 cycles） */
+    int first_errno = 0;
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        pc->fds[i] = -1;
+        int fd = open_event(PERF_CONFIGS[i], pc->group_fd);
+        if (fd < 0) {
+            if (!first_errno) first_errno = errno;
+            continue;
+        }
+        if (pc->group_fd == -1) pc->group_fd = fd;
+        pc->fds[i]       = fd;
+        pc->available[i] = true;
+        pc->slot[i]      = pc->n_open++;
+    }
+
+    if (pc->n_open == 0) {
+        snprintf(err, err_size, "perf_event_open: %s", strerror(first_errno));
+        free(pc);
+        return NULL;
+    }
+
+    ioctl(pc->group_fd, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+    ioctl(pc->group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return pc;
+}
+
+void perf_close(PerfCounters *pc) {
+    if (!pc) return;
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        if (pc->fds[i] >= 0) close(pc->fds[i]);
+    }
+    free(pc);
+}
+
+bool perf_read(const PerfCounters *pc, uint64_t out[PERF_EVENT_COUNT]) {
+    /* PERF_FORMAT_GROUP：{ nr, value[nr] } */
+    uint64_t buf[1 + PERF_EVENT_COUNT];
+    ssize_t n = read(pc->group_fd, buf, sizeof(uint64_t) * (1 + pc->n_open));
+    if (n < (ssize_t)sizeof(uint64_t) * (1 + pc->n_open)) return false;
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        out[i] = pc->available[i] ? buf[1 + pc->slot[i]] : 0;
+    }
+    return true;
+}
+
+#else   /* 不是 Linux：永远不可用 */
+
+PerfCounters *perf_open(char *err, int err_size) {
+    snprintf(err, err_size, "perf counters need Linux perf_event_open");
+    return NULL;
+}
+
+void perf_close(PerfCounters *pc) {
+    (void)pc;
+}
+
+bool perf_read(const PerfCounters *pc, uint64_t out[PERF_EVENT_COUNT]) {
+    (void)pc;
+    (void)out;
+    return false;
+}
+
+#endif
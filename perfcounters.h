@@ -0,0 +1,40 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ================== 硬件性能计数器（perf_event_open） ================== */
+
+/*
+ * 只统计本进程用户态：cycles、instructions、cache misses、branch misses
+ * 放在同一个 group 里一起读。不是 Linux、内核不允许（perf_event_paranoid）、
+ * 容器/虚拟机没有 PMU 时 perf_open 返回 NULL，并在 err 里写原因，游戏照常运行。
+ * 个别事件打不开时其余的照样用，打不开的读出来一直是 0（available[i] == false）。
+ */
+
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+} PerfEvent;
+
+typedef struct {
+    int  group_fd;
+    int  fds[PERF_EVENT_COUNT];
+    bool available[PERF_EVENT_COUNT];
+    int  slot[PERF_EVENT_COUNT];    // 在 group 读出来的数组里的下标
+    int  n_open;
+} PerfCounters;
+
+extern const char *const PERF_EVENT_NAMES[PERF_EVENT_COUNT];
+
+PerfCounters *perf_open(char *err, int err_size);
+void          perf_close(PerfCounters *pc);
+
+/* 读当前累计值；失败返回 false，out 不变 */
+bool perf_read(const PerfCounters *pc, uint64_t out[PERF_EVENT_COUNT]);
+
+#endif
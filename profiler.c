@@ -0,0 +1,205 @@
+#include "profiler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *PHASE_NAMES[PHASE_COUNT] = {
+    "input", "ai", "move", "collision", "rescue", "render", "sleep",
+};
+
+static const char *COUNTER_NAMES[COUNTER_COUNT] = {
+    "bfs_nodes_per_frame", "cells_redrawn_per_frame",
+};
+
+/* ================== 直方图 ================== */
+
+/* 0..15 各占一格；之后每个 [2^k, 2^(k+1)) 分成 16 格 */
+static int bucket_index(uint64_t v) {
+    if (v < HIST_SUB) return (int)v;
+    int msb   = 63 - __builtin_clzll(v);
+    int shift = msb - HIST_SUB_BITS;
+    int sub   = (int)((v >> shift) & (HIST_SUB - 1));
+    return (shift + 1) * HIST_SUB + sub;
+}
+
+/* 桶的上界（含） */
+static uint64_t bucket_upper(int idx) {
+    if (idx < HIST_SUB) return (uint64_t)idx;
+    int shift = idx / HIST_SUB - 1;
+    int sub   = idx % HIST_SUB;
+    return ((uint64_t)(HIST_SUB + sub + 1) << shift) - 1;
+}
+
+void hist_record(Histogram *h, uint64_t value) {
+    h->counts[bucket_index(value)]++;
+    if (h->total == 0 || value < h->min) h->min = value;
+    if (value > h->max) h->max = value;
+    h->total++;
+    h->sum += (double)value;
+}
+
+uint64_t hist_percentile(const Histogram *h, double p) {
+    if (h->total == 0) return 0;
+    uint64_t rank = (uint64_t)(p / 100.0 * (double)h->total + 0.5);
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) {
+            uint64_t v = bucket_upper(i);
+            return v > h->max ? h->max : v;
+        }
+    }
+    return h->max;
+}
+
+/* ================== Profiler ================== */
+
+Profiler *profiler_create(void) {
+    return calloc(1, sizeof(Profiler));
+}
+
+void profiler_destroy(Profiler *p) {
+    if (!p) return;
+    perf_close(p->perf);
+    free(p);
+}
+
+bool profiler_enable_perf(Profiler *p) {
+    p->perf_requested = true;
+    p->perf = perf_open(p->perf_error, sizeof(p->perf_error));
+    return p->perf != NULL;
+}
+
+void profiler_perf_begin(Profiler *p, ProfilePhase phase) {
+    perf_read(p->perf, p->perf_start[phase]);
+}
+
+void profiler_perf_end(Profiler *p, ProfilePhase phase) {
+    uint64_t now[PERF_EVENT_COUNT];
+    if (!perf_read(p->perf, now)) return;
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        p->perf_total[phase][e] += now[e] - p->perf_start[phase][e];
+    }
+}
+
+void profiler_frame_begin(Profiler *p) {
+    if (!p) return;
+    for (int c = 0; c < COUNTER_COUNT; c++) p->frame_counts[c] = 0;
+}
+
+void profiler_frame_end(Profiler *p) {
+    if (!p) return;
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        hist_record(&p->counters[c], p->frame_counts[c]);
+        p->frame_counts[c] = 0;
+    }
+    p->frames++;
+}
+
+void profiler_hud_line(const Profiler *p, char *buf, int size) {
+    int n = snprintf(buf, size, "p50/p99  ");
+    for (int i = 0; i < PHASE_COUNT && n < size; i++) {
+        if (i == PHASE_SLEEP) continue;     // sleep 就是关卡速度，HUD 上不看
+        n += snprintf(buf + n, size - n, "%s %.0f/%.0fus  ",
+                      PHASE_NAMES[i],
+                      hist_percentile(&p->phases[i], 50) / 1000.0,
+                      hist_percentile(&p->phases[i], 99) / 1000.0);
+    }
+    if (n < size) {
+        snprintf(buf + n, size - n, "bfs %llu nodes",
+                 (unsigned long long)hist_percentile(&p->counters[COUNTER_BFS_NODES], 50));
+    }
+}
+
+static void dump_hist(FILE *f, const char *name, const Histogram *h, double scale) {
+    fprintf(f, "%-24s %8llu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+            name, (unsigned long long)h->total,
+            h->total ? h->min / scale : 0.0,
+            h->total ? h->sum / h->total / scale : 0.0,
+            hist_percentile(h, 50)   / scale,
+            hist_percentile(h, 90)   / scale,
+            hist_percentile(h, 99)   / scale,
+            hist_percentile(h, 99.9) / scale,
+            h->max / scale);
+}
+
+/* HdrHistogram 风格的分布：每个非空桶一行（上界、累计百分比） */
+static void dump_distribution(FILE *f, const char *name, const Histogram *h, double scale) {
+    if (h->total == 0) return;
+    fprintf(f, "\n[%s]\n%12s %10s %10s\n", name, "value", "percentile", "count");
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        if (h->counts[i] == 0) continue;
+        seen += h->counts[i];
+        fprintf(f, "%12.2f %10.4f %10llu\n",
+                bucket_upper(i) / scale, (double)seen / h->total,
+                (unsigned long long)h->counts[i]);
+    }
+}
+
+/*
+ * 每阶段每次调用的平均硬件计数；IPC 低、每千条指令 cache miss 高
+ * 说明是卡在访存上，反之是算力上
+ */
+static void dump_perf(FILE *f, const Profiler *p) {
+    fprintf(f, "\nhardware counters (user space, per call)\n");
+    if (!p->perf) {
+        fprintf(f, "unavailable: %s\n", p->perf_error);
+        return;
+    }
+
+    fprintf(f, "%-24s %12s %12s %8s %12s %10s %12s\n",
+            "phase", "cycles", "instructions", "ipc",
+            "cache_miss", "miss/kinst", "branch_miss");
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        uint64_t calls = p->phases[i].total;
+        if (calls == 0) continue;
+        const uint64_t *t = p->perf_total[i];
+        double instr = (double)t[PERF_INSTRUCTIONS];
+        fprintf(f, "%-24s %12.0f %12.0f %8.2f %12.1f %10.2f %12.1f\n",
+                PHASE_NAMES[i],
+                (double)t[PERF_CYCLES] / calls,
+                instr / calls,
+                t[PERF_CYCLES] ? instr / t[PERF_CYCLES] : 0.0,
+                (double)t[PERF_CACHE_MISSES] / calls,
+                instr > 0 ? t[PERF_CACHE_MISSES] * 1000.0 / instr : 0.0,
+                (double)t[PERF_BRANCH_MISSES] / calls);
+    }
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        if (!p->perf->available[e])
+            fprintf(f, "(%s not supported on this host)\n", PERF_EVENT_NAMES[e]);
+    }
+}
+
+bool profiler_dump(const Profiler *p, const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+
+    fprintf(f, "frames: %llu\n\n", (unsigned long long)p->frames);
+    fprintf(f, "%-24s %8s %10s %10s %10s %10s %10s %10s %10s\n",
+            "phase (us)", "count", "min", "mean", "p50", "p90", "p99", "p99.9", "max");
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        dump_hist(f, PHASE_NAMES[i], &p->phases[i], 1000.0);
+    }
+
+    fprintf(f, "\n%-24s %8s %10s %10s %10s %10s %10s %10s %10s\n",
+            "counter", "frames", "min", "mean", "p50", "p90", "p99", "p99.9", "max");
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        dump_hist(f, COUNTER_NAMES[c], &p->counters[c], 1.0);
+    }
+
+    if (p->perf_requested) dump_perf(f, p);
+
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        dump_distribution(f, PHASE_NAMES[i], &p->phases[i], 1000.0);
+    }
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        dump_distribution(f, COUNTER_NAMES[c], &p->counters[c], 1.0);
+    }
+
+    fclose(f);
+    return true;
+}
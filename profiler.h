@@ -0,0 +1,113 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "perfcounters.h"
+
+/* ================== 每帧分阶段计时 ================== */
+
+/*
+ * 主循环每个阶段用 profiler_begin / profiler_end 包起来，
+ * 耗时（ns）记进该阶段的直方图；每帧的计数器（BFS 展开节点数、
+ * 重画格子数）在 profiler_frame_end 时也记进各自的直方图。
+ *
+ * 直方图是 HDR 风格的对数-线性分桶：每个 2 的幂区间再等分 16 格，
+ * 相对误差 < 6.25%，记录一次只是一次 clz 和一次自增，不分配内存。
+ *
+ * profiler_enable_perf 之后，每个阶段的 begin/end 还会读一次硬件计数器，
+ * 差值累加到该阶段（每次多两次 read 系统调用，只在需要时打开）。
+ */
+
+typedef enum {
+    PHASE_INPUT,
+    PHASE_AI,
+    PHASE_MOVE,
+    PHASE_COLLISION,
+    PHASE_RESCUE,
+    PHASE_RENDER,
+    PHASE_SLEEP,
+    PHASE_COUNT
+} ProfilePhase;
+
+typedef enum {
+    COUNTER_BFS_NODES,      // 本帧 BFS 展开的节点数
+    COUNTER_CELLS_REDRAWN,  // 本帧往棋盘窗口写的格子数
+    COUNTER_COUNT
+} ProfileCounter;
+
+#define HIST_SUB_BITS  4
+#define HIST_SUB       (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS   (64 * HIST_SUB)
+
+typedef struct {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    double   sum;
+} Histogram;
+
+typedef struct {
+    Histogram phases[PHASE_COUNT];
+    Histogram counters[COUNTER_COUNT];
+
+    uint64_t  phase_start[PHASE_COUNT];
+    uint64_t  frame_counts[COUNTER_COUNT];
+    uint64_t  frames;
+
+    PerfCounters *perf;             // NULL = 不读硬件计数器
+    bool      perf_requested;
+    char      perf_error[128];      // 打不开时的原因，写进报告
+    uint64_t  perf_start[PHASE_COUNT][PERF_EVENT_COUNT];
+    uint64_t  perf_total[PHASE_COUNT][PERF_EVENT_COUNT];
+} Profiler;
+
+Profiler *profiler_create(void);
+void      profiler_destroy(Profiler *p);
+
+/* 打开硬件计数器；失败返回 false，原因在 p->perf_error，计时照常 */
+bool      profiler_enable_perf(Profiler *p);
+
+static inline uint64_t profiler_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void hist_record(Histogram *h, uint64_t value);
+uint64_t hist_percentile(const Histogram *h, double p);
+
+void profiler_perf_begin(Profiler *p, ProfilePhase phase);
+void profiler_perf_end(Profiler *p, ProfilePhase phase);
+
+static inline void profiler_begin(Profiler *p, ProfilePhase phase) {
+    if (!p) return;
+    if (p->perf) profiler_perf_begin(p, phase);
+    p->phase_start[phase] = profiler_now();
+}
+
+static inline void profiler_end(Profiler *p, ProfilePhase phase) {
+    if (!p) return;
+    hist_record(&p->phases[phase], profiler_now() - p->phase_start[phase]);
+    if (p->perf) profiler_perf_end(p, phase);
+}
+
+static inline void profiler_add(Profiler *p, ProfileCounter c, uint64_t n) {
+    if (p) p->frame_counts[c] += n;
+}
+
+/* 一帧开始：清掉上一帧之后零散记进来的计数；每个 begin 配一个 end */
+void profiler_frame_begin(Profiler *p);
+/* 一帧结束：把本帧计数器记进直方图并清零 */
+void profiler_frame_end(Profiler *p);
+
+/* 一行 HUD 文本：各阶段 p50/p99（µs） */
+void profiler_hud_line(const Profiler *p, char *buf, int size);
+
+/* 退出时写报告；返回 false 表示文件打不开 */
+bool profiler_dump(const Profiler *p, const char *path);
+
+#endif
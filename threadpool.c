@@ -0,0 +1,120 @@
+#include "threadpool.h"
+#include "trace.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+struct ThreadPool {
+    pthread_mutex_t lock;
+    pthread_cond_t  start;          // 新一轮开始
+    pthread_cond_t  finished;       // worker 做完这一轮
+    unsigned long   generation;     // 第几轮；worker 靠它分辨是不是新活
+    int             busy;           // 这一轮还没做完的 worker 数
+    bool            quit;
+
+    PoolTask        fn;
+    void           *ctx;
+    int             count;
+    atomic_int      next;           // 下一个没人领的下标
+
+    int             n_workers;
+    pthread_t      *workers;
+};
+
+/* 领下标直到领完 */
+static void drain(ThreadPool *pool) {
+    for (;;) {
+        int i = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed);
+        if (i >= pool->count) break;
+        pool->fn(pool->ctx, i);
+    }
+}
+
+static void *worker_main(void *arg) {
+    ThreadPool *pool = arg;
+    trace_thread_name("pool_worker");
+
+    unsigned long seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->generation == seen)
+            pthread_cond_wait(&pool->start, &pool->lock);
+        if (pool->quit) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        drain(pool);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) pthread_cond_signal(&pool->finished);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ThreadPool *pool_create(int threads) {
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+    if (threads < 1) threads = 1;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->finished, NULL);
+    atomic_init(&pool->next, 0);
+
+    pool->workers = calloc((size_t)threads, sizeof(pthread_t));
+    if (!pool->workers) threads = 1;
+    for (int i = 0; i < threads - 1; i++) {
+        if (pthread_create(&pool->workers[i], NULL, worker_main, pool) != 0) break;
+        pool->n_workers++;
+    }
+    return pool;
+}
+
+void pool_destroy(ThreadPool *pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->n_workers; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+    pthread_cond_destroy(&pool->finished);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+int pool_threads(const ThreadPool *pool) {
+    return pool->n_workers + 1;
+}
+
+void pool_run(ThreadPool *pool, PoolTask fn, void *ctx, int count) {
+    if (pool->n_workers == 0 || count <= 1) {
+        for (int i = 0; i < count; i++) fn(ctx, i);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn    = fn;
+    pool->ctx   = ctx;
+    pool->count = count;
+    atomic_store_explicit(&pool->next, 0, memory_order_relaxed);
+    pool->busy  = pool->n_workers;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    drain(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy > 0)
+        pthread_cond_wait(&pool->finished, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
@@ -0,0 +1,26 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/* ================== 固定大小的线程池 ================== */
+
+/*
+ * pool_run(pool, fn, ctx, count) 把 fn(ctx, 0) … fn(ctx, count-1) 分给所有线程做，
+ * 调用线程自己也干活，全部做完才返回。下标用一个原子计数器领取，
+ * 快的线程多做几个，不用事先切块。两轮之间 worker 睡在条件变量上。
+ * threads = 1 时不起线程，直接在调用线程里顺序跑。
+ *
+ * 同一个池不能被两个线程同时 pool_run。
+ */
+
+typedef void (*PoolTask)(void *ctx, int index);
+
+typedef struct ThreadPool ThreadPool;
+
+/* threads 包括调用线程自己；起线程失败时能起几个用几个 */
+ThreadPool *pool_create(int threads);
+void        pool_destroy(ThreadPool *pool);
+
+int  pool_threads(const ThreadPool *pool);
+void pool_run(ThreadPool *pool, PoolTask fn, void *ctx, int count);
+
+#endif
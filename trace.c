@@ -0,0 +1,148 @@
+#include "trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TRACE_CHUNK_EVENTS 4096
+
+typedef struct {
+    const char *name;
+    uint64_t    ts_ns;
+    char        ph;         // 'B' 开始 / 'E' 结束 / 'i' 瞬时
+} TraceEvent;
+
+typedef struct TraceChunk {
+    TraceEvent         events[TRACE_CHUNK_EVENTS];
+    atomic_int         count;   // 写完一条再 release，读的一方不会看到半条
+    struct TraceChunk *next;
+} TraceChunk;
+
+typedef struct TraceBuffer {
+    int                 tid;
+    const char         *thread_name;
+    TraceChunk         *head;
+    TraceChunk         *tail;
+    struct TraceBuffer *next;   // 全局链表
+} TraceBuffer;
+
+atomic_bool trace_on;
+
+static _Atomic(TraceBuffer *) buffers;    // 所有线程的缓冲区（只增不减）
+static atomic_int             next_tid = 1;
+static uint64_t               trace_t0;
+
+static _Thread_local TraceBuffer *local_buffer;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* ================== 每线程缓冲区 ================== */
+
+static TraceChunk *new_chunk(void) {
+    TraceChunk *c = malloc(sizeof(TraceChunk));
+    if (!c) return NULL;
+    atomic_init(&c->count, 0);
+    c->next = NULL;
+    return c;
+}
+
+static TraceBuffer *get_buffer(void) {
+    if (local_buffer) return local_buffer;
+
+    TraceBuffer *b = calloc(1, sizeof(TraceBuffer));
+    if (!b) return NULL;
+    b->head = b->tail = new_chunk();
+    if (!b->head) {
+        free(b);
+        return NULL;
+    }
+    b->tid = atomic_fetch_add(&next_tid, 1);
+
+    /* 无锁压栈到全局链表 */
+    TraceBuffer *old = atomic_load(&buffers);
+    do {
+        b->next = old;
+    } while (!atomic_compare_exchange_weak(&buffers, &old, b));
+
+    local_buffer = b;
+    return b;
+}
+
+static void record(const char *name, char ph) {
+    TraceBuffer *b = get_buffer();
+    if (!b) return;
+
+    TraceChunk *c = b->tail;
+    int n = atomic_load_explicit(&c->count, memory_order_relaxed);
+    if (n == TRACE_CHUNK_EVENTS) {
+        TraceChunk *fresh = new_chunk();
+        if (!fresh) return;     // 内存不够就丢事件，不影响游戏
+        c->next = fresh;
+        b->tail = c = fresh;
+        n = 0;
+    }
+
+    c->events[n].name  = name;
+    c->events[n].ts_ns = now_ns();
+    c->events[n].ph    = ph;
+    atomic_store_explicit(&c->count, n + 1, memory_order_release);
+}
+
+/* ================== 对外接口 ================== */
+
+void trace_start(void) {
+    trace_t0 = now_ns();
+    atomic_store(&trace_on, true);
+}
+
+void trace_begin(const char *name)   { record(name, 'B'); }
+void trace_end(const char *name)     { record(name, 'E'); }
+void trace_instant(const char *name) { record(name, 'i'); }
+
+void trace_thread_name(const char *name) {
+    if (!atomic_load_explicit(&trace_on, memory_order_relaxed)) return;
+    TraceBuffer *b = get_buffer();
+    if (b) b->thread_name = name;
+}
+
+bool trace_write(const char *path) {
+    atomic_store(&trace_on, false);
+
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+
+    int pid = (int)getpid();
+    bool first = true;
+    fprintf(f, "{\"traceEvents\":[\n");
+
+    for (TraceBuffer *b = atomic_load(&buffers); b; b = b->next) {
+        if (b->thread_name) {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                       "\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",\n", pid, b->tid, b->thread_name);
+            first = false;
+        }
+        for (TraceChunk *c = b->head; c; c = c->next) {
+            int n = atomic_load_explicit(&c->count, memory_order_acquire);
+            for (int i = 0; i < n; i++) {
+                const TraceEvent *e = &c->events[i];
+                double ts_us = (double)(e->ts_ns - trace_t0) / 1000.0;
+                fprintf(f, "%s{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"%c\","
+                           "\"ts\":%.3f,\"pid\":%d,\"tid\":%d%s}",
+                        first ? "" : ",\n", e->name, e->ph, ts_us, pid, b->tid,
+                        e->ph == 'i' ? ",\"s\":\"t\"" : "");
+                first = false;
+            }
+        }
+    }
+
+    fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/* ================== Chrome trace-event 导出 ================== */
+
+/*
+ * --trace out.json 时记录开始/结束事件，退出时写成 Chrome trace-event
+ * JSON（chrome://tracing、Perfetto 都能打开），在时间线上看帧间隔和卡顿。
+ *
+ * 每个线程第一次记录时分配自己的缓冲区，用 CAS 挂到全局链表上；
+ * 之后只有本线程往里写，记录一条事件不加锁、不做系统调用（缓冲满了才 malloc 新块）。
+ * trace_write 在其他线程都停下之后调用（退出前）。
+ * 没开 trace 时 TRACE_BEGIN/END 只是一次原子读。
+ *
+ * name 必须是字符串常量：只存指针，写文件时才读。
+ */
+
+extern atomic_bool trace_on;
+
+void trace_start(void);
+void trace_begin(const char *name);
+void trace_end(const char *name);
+void trace_instant(const char *name);
+
+/* 给当前线程起名字，显示在时间线左侧 */
+void trace_thread_name(const char *name);
+
+/* 写 JSON 并停止记录；返回 false 表示文件打不开 */
+bool trace_write(const char *path);
+
+#define TRACE_BEGIN(name) \
+    do { if (atomic_load_explicit(&trace_on, memory_order_relaxed)) trace_begin(name); } while (0)
+#define TRACE_END(name) \
+    do { if (atomic_load_explicit(&trace_on, memory_order_relaxed)) trace_end(name); } while (0)
+#define TRACE_INSTANT(name) \
+    do { if (atomic_load_explicit(&trace_on, memory_order_relaxed)) trace_instant(name); } while (0)
+
+#endif